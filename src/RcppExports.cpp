@@ -86,35 +86,41 @@ BEGIN_RCPP
 END_RCPP
 }
 // cpp_s2_area
-NumericVector cpp_s2_area(List geog);
-RcppExport SEXP _s2_cpp_s2_area(SEXP geogSEXP) {
+NumericVector cpp_s2_area(List geog, bool approx, int numThreads);
+RcppExport SEXP _s2_cpp_s2_area(SEXP geogSEXP, SEXP approxSEXP, SEXP numThreadsSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< List >::type geog(geogSEXP);
-    rcpp_result_gen = Rcpp::wrap(cpp_s2_area(geog));
+    Rcpp::traits::input_parameter< bool >::type approx(approxSEXP);
+    Rcpp::traits::input_parameter< int >::type numThreads(numThreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_area(geog, approx, numThreads));
     return rcpp_result_gen;
 END_RCPP
 }
 // cpp_s2_length
-NumericVector cpp_s2_length(List geog);
-RcppExport SEXP _s2_cpp_s2_length(SEXP geogSEXP) {
+NumericVector cpp_s2_length(List geog, bool approx, int numThreads);
+RcppExport SEXP _s2_cpp_s2_length(SEXP geogSEXP, SEXP approxSEXP, SEXP numThreadsSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< List >::type geog(geogSEXP);
-    rcpp_result_gen = Rcpp::wrap(cpp_s2_length(geog));
+    Rcpp::traits::input_parameter< bool >::type approx(approxSEXP);
+    Rcpp::traits::input_parameter< int >::type numThreads(numThreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_length(geog, approx, numThreads));
     return rcpp_result_gen;
 END_RCPP
 }
 // cpp_s2_perimeter
-NumericVector cpp_s2_perimeter(List geog);
-RcppExport SEXP _s2_cpp_s2_perimeter(SEXP geogSEXP) {
+NumericVector cpp_s2_perimeter(List geog, bool approx, int numThreads);
+RcppExport SEXP _s2_cpp_s2_perimeter(SEXP geogSEXP, SEXP approxSEXP, SEXP numThreadsSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< List >::type geog(geogSEXP);
-    rcpp_result_gen = Rcpp::wrap(cpp_s2_perimeter(geog));
+    Rcpp::traits::input_parameter< bool >::type approx(approxSEXP);
+    Rcpp::traits::input_parameter< int >::type numThreads(numThreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_perimeter(geog, approx, numThreads));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -140,39 +146,98 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
-// cpp_s2_project_normalized
-NumericVector cpp_s2_project_normalized(List geog1, List geog2);
-RcppExport SEXP _s2_cpp_s2_project_normalized(SEXP geog1SEXP, SEXP geog2SEXP) {
+// cpp_s2_project
+NumericVector cpp_s2_project(List geog1, List geog2, bool normalized, int numThreads);
+RcppExport SEXP _s2_cpp_s2_project(SEXP geog1SEXP, SEXP geog2SEXP, SEXP normalizedSEXP, SEXP numThreadsSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< List >::type geog1(geog1SEXP);
     Rcpp::traits::input_parameter< List >::type geog2(geog2SEXP);
-    rcpp_result_gen = Rcpp::wrap(cpp_s2_project_normalized(geog1, geog2));
+    Rcpp::traits::input_parameter< bool >::type normalized(normalizedSEXP);
+    Rcpp::traits::input_parameter< int >::type numThreads(numThreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_project(geog1, geog2, normalized, numThreads));
     return rcpp_result_gen;
 END_RCPP
 }
 // cpp_s2_distance
-NumericVector cpp_s2_distance(List geog1, List geog2);
-RcppExport SEXP _s2_cpp_s2_distance(SEXP geog1SEXP, SEXP geog2SEXP) {
+NumericVector cpp_s2_distance(List geog1, List geog2, NumericVector maxError);
+RcppExport SEXP _s2_cpp_s2_distance(SEXP geog1SEXP, SEXP geog2SEXP, SEXP maxErrorSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< List >::type geog1(geog1SEXP);
     Rcpp::traits::input_parameter< List >::type geog2(geog2SEXP);
-    rcpp_result_gen = Rcpp::wrap(cpp_s2_distance(geog1, geog2));
+    Rcpp::traits::input_parameter< NumericVector >::type maxError(maxErrorSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_distance(geog1, geog2, maxError));
     return rcpp_result_gen;
 END_RCPP
 }
 // cpp_s2_max_distance
-NumericVector cpp_s2_max_distance(List geog1, List geog2);
-RcppExport SEXP _s2_cpp_s2_max_distance(SEXP geog1SEXP, SEXP geog2SEXP) {
+NumericVector cpp_s2_max_distance(List geog1, List geog2, NumericVector maxError);
+RcppExport SEXP _s2_cpp_s2_max_distance(SEXP geog1SEXP, SEXP geog2SEXP, SEXP maxErrorSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< List >::type geog1(geog1SEXP);
     Rcpp::traits::input_parameter< List >::type geog2(geog2SEXP);
-    rcpp_result_gen = Rcpp::wrap(cpp_s2_max_distance(geog1, geog2));
+    Rcpp::traits::input_parameter< NumericVector >::type maxError(maxErrorSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_max_distance(geog1, geog2, maxError));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cpp_s2_hausdorff_distance
+NumericVector cpp_s2_hausdorff_distance(List geog1, List geog2, bool directed, NumericVector maxDistance, int numThreads);
+RcppExport SEXP _s2_cpp_s2_hausdorff_distance(SEXP geog1SEXP, SEXP geog2SEXP, SEXP directedSEXP, SEXP maxDistanceSEXP, SEXP numThreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type geog1(geog1SEXP);
+    Rcpp::traits::input_parameter< List >::type geog2(geog2SEXP);
+    Rcpp::traits::input_parameter< bool >::type directed(directedSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type maxDistance(maxDistanceSEXP);
+    Rcpp::traits::input_parameter< int >::type numThreads(numThreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_hausdorff_distance(geog1, geog2, directed, maxDistance, numThreads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cpp_s2_alignment_cost
+NumericVector cpp_s2_alignment_cost(List geog1, List geog2, int method, int numThreads);
+RcppExport SEXP _s2_cpp_s2_alignment_cost(SEXP geog1SEXP, SEXP geog2SEXP, SEXP methodSEXP, SEXP numThreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type geog1(geog1SEXP);
+    Rcpp::traits::input_parameter< List >::type geog2(geog2SEXP);
+    Rcpp::traits::input_parameter< int >::type method(methodSEXP);
+    Rcpp::traits::input_parameter< int >::type numThreads(numThreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_alignment_cost(geog1, geog2, method, numThreads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cpp_s2_distance_point_vector
+NumericVector cpp_s2_distance_point_vector(List x, List y, NumericVector maxError);
+RcppExport SEXP _s2_cpp_s2_distance_point_vector(SEXP xSEXP, SEXP ySEXP, SEXP maxErrorSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type x(xSEXP);
+    Rcpp::traits::input_parameter< List >::type y(ySEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type maxError(maxErrorSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_distance_point_vector(x, y, maxError));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cpp_s2_max_distance_point_vector
+NumericVector cpp_s2_max_distance_point_vector(List x, List y, NumericVector maxError);
+RcppExport SEXP _s2_cpp_s2_max_distance_point_vector(SEXP xSEXP, SEXP ySEXP, SEXP maxErrorSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type x(xSEXP);
+    Rcpp::traits::input_parameter< List >::type y(ySEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type maxError(maxErrorSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_max_distance_point_vector(x, y, maxError));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -221,74 +286,114 @@ BEGIN_RCPP
 END_RCPP
 }
 // cpp_s2_cell_union_contains
-LogicalVector cpp_s2_cell_union_contains(List cellUnionVector1, List cellUnionVector2);
-RcppExport SEXP _s2_cpp_s2_cell_union_contains(SEXP cellUnionVector1SEXP, SEXP cellUnionVector2SEXP) {
+LogicalVector cpp_s2_cell_union_contains(List cellUnionVector1, List cellUnionVector2, int numThreads);
+RcppExport SEXP _s2_cpp_s2_cell_union_contains(SEXP cellUnionVector1SEXP, SEXP cellUnionVector2SEXP, SEXP numThreadsSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< List >::type cellUnionVector1(cellUnionVector1SEXP);
     Rcpp::traits::input_parameter< List >::type cellUnionVector2(cellUnionVector2SEXP);
-    rcpp_result_gen = Rcpp::wrap(cpp_s2_cell_union_contains(cellUnionVector1, cellUnionVector2));
+    Rcpp::traits::input_parameter< int >::type numThreads(numThreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_cell_union_contains(cellUnionVector1, cellUnionVector2, numThreads));
     return rcpp_result_gen;
 END_RCPP
 }
 // cpp_s2_cell_union_contains_cell
-LogicalVector cpp_s2_cell_union_contains_cell(List cellUnionVector, NumericVector cellIdVector);
-RcppExport SEXP _s2_cpp_s2_cell_union_contains_cell(SEXP cellUnionVectorSEXP, SEXP cellIdVectorSEXP) {
+LogicalVector cpp_s2_cell_union_contains_cell(List cellUnionVector, NumericVector cellIdVector, int numThreads);
+RcppExport SEXP _s2_cpp_s2_cell_union_contains_cell(SEXP cellUnionVectorSEXP, SEXP cellIdVectorSEXP, SEXP numThreadsSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< List >::type cellUnionVector(cellUnionVectorSEXP);
     Rcpp::traits::input_parameter< NumericVector >::type cellIdVector(cellIdVectorSEXP);
-    rcpp_result_gen = Rcpp::wrap(cpp_s2_cell_union_contains_cell(cellUnionVector, cellIdVector));
+    Rcpp::traits::input_parameter< int >::type numThreads(numThreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_cell_union_contains_cell(cellUnionVector, cellIdVector, numThreads));
     return rcpp_result_gen;
 END_RCPP
 }
 // cpp_s2_cell_union_intersects
-LogicalVector cpp_s2_cell_union_intersects(List cellUnionVector1, List cellUnionVector2);
-RcppExport SEXP _s2_cpp_s2_cell_union_intersects(SEXP cellUnionVector1SEXP, SEXP cellUnionVector2SEXP) {
+LogicalVector cpp_s2_cell_union_intersects(List cellUnionVector1, List cellUnionVector2, int numThreads);
+RcppExport SEXP _s2_cpp_s2_cell_union_intersects(SEXP cellUnionVector1SEXP, SEXP cellUnionVector2SEXP, SEXP numThreadsSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< List >::type cellUnionVector1(cellUnionVector1SEXP);
     Rcpp::traits::input_parameter< List >::type cellUnionVector2(cellUnionVector2SEXP);
-    rcpp_result_gen = Rcpp::wrap(cpp_s2_cell_union_intersects(cellUnionVector1, cellUnionVector2));
+    Rcpp::traits::input_parameter< int >::type numThreads(numThreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_cell_union_intersects(cellUnionVector1, cellUnionVector2, numThreads));
     return rcpp_result_gen;
 END_RCPP
 }
 // cpp_s2_cell_union_intersection
-List cpp_s2_cell_union_intersection(List cellUnionVector1, List cellUnionVector2);
-RcppExport SEXP _s2_cpp_s2_cell_union_intersection(SEXP cellUnionVector1SEXP, SEXP cellUnionVector2SEXP) {
+List cpp_s2_cell_union_intersection(List cellUnionVector1, List cellUnionVector2, int numThreads);
+RcppExport SEXP _s2_cpp_s2_cell_union_intersection(SEXP cellUnionVector1SEXP, SEXP cellUnionVector2SEXP, SEXP numThreadsSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< List >::type cellUnionVector1(cellUnionVector1SEXP);
     Rcpp::traits::input_parameter< List >::type cellUnionVector2(cellUnionVector2SEXP);
-    rcpp_result_gen = Rcpp::wrap(cpp_s2_cell_union_intersection(cellUnionVector1, cellUnionVector2));
+    Rcpp::traits::input_parameter< int >::type numThreads(numThreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_cell_union_intersection(cellUnionVector1, cellUnionVector2, numThreads));
     return rcpp_result_gen;
 END_RCPP
 }
 // cpp_s2_cell_union_union
-List cpp_s2_cell_union_union(List cellUnionVector1, List cellUnionVector2);
-RcppExport SEXP _s2_cpp_s2_cell_union_union(SEXP cellUnionVector1SEXP, SEXP cellUnionVector2SEXP) {
+List cpp_s2_cell_union_union(List cellUnionVector1, List cellUnionVector2, int numThreads);
+RcppExport SEXP _s2_cpp_s2_cell_union_union(SEXP cellUnionVector1SEXP, SEXP cellUnionVector2SEXP, SEXP numThreadsSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< List >::type cellUnionVector1(cellUnionVector1SEXP);
     Rcpp::traits::input_parameter< List >::type cellUnionVector2(cellUnionVector2SEXP);
-    rcpp_result_gen = Rcpp::wrap(cpp_s2_cell_union_union(cellUnionVector1, cellUnionVector2));
+    Rcpp::traits::input_parameter< int >::type numThreads(numThreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_cell_union_union(cellUnionVector1, cellUnionVector2, numThreads));
     return rcpp_result_gen;
 END_RCPP
 }
 // cpp_s2_cell_union_difference
-List cpp_s2_cell_union_difference(List cellUnionVector1, List cellUnionVector2);
-RcppExport SEXP _s2_cpp_s2_cell_union_difference(SEXP cellUnionVector1SEXP, SEXP cellUnionVector2SEXP) {
+List cpp_s2_cell_union_difference(List cellUnionVector1, List cellUnionVector2, int numThreads);
+RcppExport SEXP _s2_cpp_s2_cell_union_difference(SEXP cellUnionVector1SEXP, SEXP cellUnionVector2SEXP, SEXP numThreadsSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< List >::type cellUnionVector1(cellUnionVector1SEXP);
     Rcpp::traits::input_parameter< List >::type cellUnionVector2(cellUnionVector2SEXP);
-    rcpp_result_gen = Rcpp::wrap(cpp_s2_cell_union_difference(cellUnionVector1, cellUnionVector2));
+    Rcpp::traits::input_parameter< int >::type numThreads(numThreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_cell_union_difference(cellUnionVector1, cellUnionVector2, numThreads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cpp_s2_cell_union_encode
+List cpp_s2_cell_union_encode(List cellUnionVector);
+RcppExport SEXP _s2_cpp_s2_cell_union_encode(SEXP cellUnionVectorSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type cellUnionVector(cellUnionVectorSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_cell_union_encode(cellUnionVector));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cpp_s2_cell_union_decode
+List cpp_s2_cell_union_decode(List encodedVector);
+RcppExport SEXP _s2_cpp_s2_cell_union_decode(SEXP encodedVectorSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type encodedVector(encodedVectorSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_cell_union_decode(encodedVector));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cpp_s2_cell_union_encoded_contains_cell
+LogicalVector cpp_s2_cell_union_encoded_contains_cell(List encodedVector, NumericVector cellIdVector);
+RcppExport SEXP _s2_cpp_s2_cell_union_encoded_contains_cell(SEXP encodedVectorSEXP, SEXP cellIdVectorSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type encodedVector(encodedVectorSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type cellIdVector(cellIdVectorSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_cell_union_encoded_contains_cell(encodedVector, cellIdVector));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -319,6 +424,37 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// cpp_s2_covering_cell_ids_table
+List cpp_s2_covering_cell_ids_table(List geog, int min_level, int max_level, int max_cells, NumericVector buffer, bool interior, int numThreads);
+RcppExport SEXP _s2_cpp_s2_covering_cell_ids_table(SEXP geogSEXP, SEXP min_levelSEXP, SEXP max_levelSEXP, SEXP max_cellsSEXP, SEXP bufferSEXP, SEXP interiorSEXP, SEXP numThreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type geog(geogSEXP);
+    Rcpp::traits::input_parameter< int >::type min_level(min_levelSEXP);
+    Rcpp::traits::input_parameter< int >::type max_level(max_levelSEXP);
+    Rcpp::traits::input_parameter< int >::type max_cells(max_cellsSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type buffer(bufferSEXP);
+    Rcpp::traits::input_parameter< bool >::type interior(interiorSEXP);
+    Rcpp::traits::input_parameter< int >::type numThreads(numThreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_covering_cell_ids_table(geog, min_level, max_level, max_cells, buffer, interior, numThreads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cpp_s2_covering_cell_ids_table_point_vector
+List cpp_s2_covering_cell_ids_table_point_vector(List x, int min_level, int max_level, int numThreads);
+RcppExport SEXP _s2_cpp_s2_covering_cell_ids_table_point_vector(SEXP xSEXP, SEXP min_levelSEXP, SEXP max_levelSEXP, SEXP numThreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type x(xSEXP);
+    Rcpp::traits::input_parameter< int >::type min_level(min_levelSEXP);
+    Rcpp::traits::input_parameter< int >::type max_level(max_levelSEXP);
+    Rcpp::traits::input_parameter< int >::type numThreads(numThreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_covering_cell_ids_table_point_vector(x, min_level, max_level, numThreads));
+    return rcpp_result_gen;
+END_RCPP
+}
 // cpp_s2_covering_cell_ids_agg
 List cpp_s2_covering_cell_ids_agg(List geog, int min_level, int max_level, int max_cells, double buffer, bool interior, bool naRm);
 RcppExport SEXP _s2_cpp_s2_covering_cell_ids_agg(SEXP geogSEXP, SEXP min_levelSEXP, SEXP max_levelSEXP, SEXP max_cellsSEXP, SEXP bufferSEXP, SEXP interiorSEXP, SEXP naRmSEXP) {
@@ -572,6 +708,21 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// cpp_s2_cell_neighbourhood
+SEXP cpp_s2_cell_neighbourhood(NumericVector cellIdVector, IntegerVector k, bool edgeOnly, bool flatten, int numThreads);
+RcppExport SEXP _s2_cpp_s2_cell_neighbourhood(SEXP cellIdVectorSEXP, SEXP kSEXP, SEXP edgeOnlySEXP, SEXP flattenSEXP, SEXP numThreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type cellIdVector(cellIdVectorSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type k(kSEXP);
+    Rcpp::traits::input_parameter< bool >::type edgeOnly(edgeOnlySEXP);
+    Rcpp::traits::input_parameter< bool >::type flatten(flattenSEXP);
+    Rcpp::traits::input_parameter< int >::type numThreads(numThreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_cell_neighbourhood(cellIdVector, k, edgeOnly, flatten, numThreads));
+    return rcpp_result_gen;
+END_RCPP
+}
 // cpp_s2_cell_cummax
 NumericVector cpp_s2_cell_cummax(NumericVector cellIdVector);
 RcppExport SEXP _s2_cpp_s2_cell_cummax(SEXP cellIdVectorSEXP) {
@@ -737,6 +888,80 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// cpp_s2_cell_histogram
+List cpp_s2_cell_histogram(NumericVector cellIdVector, NumericVector weight, IntegerVector level, int numThreads);
+RcppExport SEXP _s2_cpp_s2_cell_histogram(SEXP cellIdVectorSEXP, SEXP weightSEXP, SEXP levelSEXP, SEXP numThreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type cellIdVector(cellIdVectorSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type weight(weightSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type level(levelSEXP);
+    Rcpp::traits::input_parameter< int >::type numThreads(numThreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_cell_histogram(cellIdVector, weight, level, numThreads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cpp_s2_cell_histogram_lnglat
+List cpp_s2_cell_histogram_lnglat(List lnglat, NumericVector weight, IntegerVector level, int numThreads);
+RcppExport SEXP _s2_cpp_s2_cell_histogram_lnglat(SEXP lnglatSEXP, SEXP weightSEXP, SEXP levelSEXP, SEXP numThreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type lnglat(lnglatSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type weight(weightSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type level(levelSEXP);
+    Rcpp::traits::input_parameter< int >::type numThreads(numThreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_cell_histogram_lnglat(lnglat, weight, level, numThreads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cpp_s2_cell_encode
+RawVector cpp_s2_cell_encode(NumericVector cellIdVector);
+RcppExport SEXP _s2_cpp_s2_cell_encode(SEXP cellIdVectorSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type cellIdVector(cellIdVectorSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_cell_encode(cellIdVector));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cpp_s2_cell_decode
+NumericVector cpp_s2_cell_decode(RawVector encoded, SEXP indices);
+RcppExport SEXP _s2_cpp_s2_cell_decode(SEXP encodedSEXP, SEXP indicesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< RawVector >::type encoded(encodedSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type indices(indicesSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_cell_decode(encoded, indices));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cpp_s2_cell_encoded_size
+SEXP cpp_s2_cell_encoded_size(RawVector encoded);
+RcppExport SEXP _s2_cpp_s2_cell_encoded_size(SEXP encodedSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< RawVector >::type encoded(encodedSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_cell_encoded_size(encoded));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cpp_s2_cell_encoded_lower_bound
+IntegerVector cpp_s2_cell_encoded_lower_bound(RawVector encoded, NumericVector cellIdVector);
+RcppExport SEXP _s2_cpp_s2_cell_encoded_lower_bound(SEXP encodedSEXP, SEXP cellIdVectorSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< RawVector >::type encoded(encodedSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type cellIdVector(cellIdVectorSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_cell_encoded_lower_bound(encoded, cellIdVector));
+    return rcpp_result_gen;
+END_RCPP
+}
 // s2_geography_full
 List s2_geography_full(LogicalVector x);
 RcppExport SEXP _s2_s2_geography_full(SEXP xSEXP) {
@@ -782,14 +1007,28 @@ BEGIN_RCPP
 END_RCPP
 }
 // cpp_s2_closest_feature
-IntegerVector cpp_s2_closest_feature(List geog1, List geog2);
-RcppExport SEXP _s2_cpp_s2_closest_feature(SEXP geog1SEXP, SEXP geog2SEXP) {
+IntegerVector cpp_s2_closest_feature(List geog1, List geog2, double maxError);
+RcppExport SEXP _s2_cpp_s2_closest_feature(SEXP geog1SEXP, SEXP geog2SEXP, SEXP maxErrorSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< List >::type geog1(geog1SEXP);
     Rcpp::traits::input_parameter< List >::type geog2(geog2SEXP);
-    rcpp_result_gen = Rcpp::wrap(cpp_s2_closest_feature(geog1, geog2));
+    Rcpp::traits::input_parameter< double >::type maxError(maxErrorSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_closest_feature(geog1, geog2, maxError));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cpp_s2_closest_feature_point_vector
+IntegerVector cpp_s2_closest_feature_point_vector(List x, List geog2, double maxError);
+RcppExport SEXP _s2_cpp_s2_closest_feature_point_vector(SEXP xSEXP, SEXP geog2SEXP, SEXP maxErrorSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type x(xSEXP);
+    Rcpp::traits::input_parameter< List >::type geog2(geog2SEXP);
+    Rcpp::traits::input_parameter< double >::type maxError(maxErrorSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_closest_feature_point_vector(x, geog2, maxError));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -913,27 +1152,84 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// cpp_s2_dwithin_matrix_point_vector
+List cpp_s2_dwithin_matrix_point_vector(List x, List geog2, double distance);
+RcppExport SEXP _s2_cpp_s2_dwithin_matrix_point_vector(SEXP xSEXP, SEXP geog2SEXP, SEXP distanceSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type x(xSEXP);
+    Rcpp::traits::input_parameter< List >::type geog2(geog2SEXP);
+    Rcpp::traits::input_parameter< double >::type distance(distanceSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_dwithin_matrix_point_vector(x, geog2, distance));
+    return rcpp_result_gen;
+END_RCPP
+}
 // cpp_s2_distance_matrix
-NumericMatrix cpp_s2_distance_matrix(List geog1, List geog2);
-RcppExport SEXP _s2_cpp_s2_distance_matrix(SEXP geog1SEXP, SEXP geog2SEXP) {
+NumericMatrix cpp_s2_distance_matrix(List geog1, List geog2, double maxError);
+RcppExport SEXP _s2_cpp_s2_distance_matrix(SEXP geog1SEXP, SEXP geog2SEXP, SEXP maxErrorSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< List >::type geog1(geog1SEXP);
     Rcpp::traits::input_parameter< List >::type geog2(geog2SEXP);
-    rcpp_result_gen = Rcpp::wrap(cpp_s2_distance_matrix(geog1, geog2));
+    Rcpp::traits::input_parameter< double >::type maxError(maxErrorSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_distance_matrix(geog1, geog2, maxError));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cpp_s2_distance_matrix_point_vector
+NumericMatrix cpp_s2_distance_matrix_point_vector(List x, List geog2, double maxError);
+RcppExport SEXP _s2_cpp_s2_distance_matrix_point_vector(SEXP xSEXP, SEXP geog2SEXP, SEXP maxErrorSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type x(xSEXP);
+    Rcpp::traits::input_parameter< List >::type geog2(geog2SEXP);
+    Rcpp::traits::input_parameter< double >::type maxError(maxErrorSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_distance_matrix_point_vector(x, geog2, maxError));
     return rcpp_result_gen;
 END_RCPP
 }
 // cpp_s2_max_distance_matrix
-NumericMatrix cpp_s2_max_distance_matrix(List geog1, List geog2);
-RcppExport SEXP _s2_cpp_s2_max_distance_matrix(SEXP geog1SEXP, SEXP geog2SEXP) {
+NumericMatrix cpp_s2_max_distance_matrix(List geog1, List geog2, double maxError);
+RcppExport SEXP _s2_cpp_s2_max_distance_matrix(SEXP geog1SEXP, SEXP geog2SEXP, SEXP maxErrorSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type geog1(geog1SEXP);
+    Rcpp::traits::input_parameter< List >::type geog2(geog2SEXP);
+    Rcpp::traits::input_parameter< double >::type maxError(maxErrorSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_max_distance_matrix(geog1, geog2, maxError));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cpp_s2_hausdorff_distance_matrix
+NumericMatrix cpp_s2_hausdorff_distance_matrix(List geog1, List geog2, bool directed, double maxDistance, int numThreads);
+RcppExport SEXP _s2_cpp_s2_hausdorff_distance_matrix(SEXP geog1SEXP, SEXP geog2SEXP, SEXP directedSEXP, SEXP maxDistanceSEXP, SEXP numThreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type geog1(geog1SEXP);
+    Rcpp::traits::input_parameter< List >::type geog2(geog2SEXP);
+    Rcpp::traits::input_parameter< bool >::type directed(directedSEXP);
+    Rcpp::traits::input_parameter< double >::type maxDistance(maxDistanceSEXP);
+    Rcpp::traits::input_parameter< int >::type numThreads(numThreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_hausdorff_distance_matrix(geog1, geog2, directed, maxDistance, numThreads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cpp_s2_alignment_cost_matrix
+NumericMatrix cpp_s2_alignment_cost_matrix(List geog1, List geog2, int method, int numThreads);
+RcppExport SEXP _s2_cpp_s2_alignment_cost_matrix(SEXP geog1SEXP, SEXP geog2SEXP, SEXP methodSEXP, SEXP numThreadsSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< List >::type geog1(geog1SEXP);
     Rcpp::traits::input_parameter< List >::type geog2(geog2SEXP);
-    rcpp_result_gen = Rcpp::wrap(cpp_s2_max_distance_matrix(geog1, geog2));
+    Rcpp::traits::input_parameter< int >::type method(methodSEXP);
+    Rcpp::traits::input_parameter< int >::type numThreads(numThreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_alignment_cost_matrix(geog1, geog2, method, numThreads));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -1067,6 +1363,20 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// cpp_s2_relations
+IntegerVector cpp_s2_relations(List geog1, List geog2, int relations, List s2options);
+RcppExport SEXP _s2_cpp_s2_relations(SEXP geog1SEXP, SEXP geog2SEXP, SEXP relationsSEXP, SEXP s2optionsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type geog1(geog1SEXP);
+    Rcpp::traits::input_parameter< List >::type geog2(geog2SEXP);
+    Rcpp::traits::input_parameter< int >::type relations(relationsSEXP);
+    Rcpp::traits::input_parameter< List >::type s2options(s2optionsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_relations(geog1, geog2, relations, s2options));
+    return rcpp_result_gen;
+END_RCPP
+}
 // cpp_s2_dwithin
 LogicalVector cpp_s2_dwithin(List geog1, List geog2, NumericVector distance);
 RcppExport SEXP _s2_cpp_s2_dwithin(SEXP geog1SEXP, SEXP geog2SEXP, SEXP distanceSEXP) {
@@ -1080,6 +1390,19 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// cpp_s2_dwithin_point_vector
+LogicalVector cpp_s2_dwithin_point_vector(List x, List y, NumericVector distance);
+RcppExport SEXP _s2_cpp_s2_dwithin_point_vector(SEXP xSEXP, SEXP ySEXP, SEXP distanceSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type x(xSEXP);
+    Rcpp::traits::input_parameter< List >::type y(ySEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type distance(distanceSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_dwithin_point_vector(x, y, distance));
+    return rcpp_result_gen;
+END_RCPP
+}
 // cpp_s2_prepared_dwithin
 LogicalVector cpp_s2_prepared_dwithin(List geog1, List geog2, NumericVector distance);
 RcppExport SEXP _s2_cpp_s2_prepared_dwithin(SEXP geog1SEXP, SEXP geog2SEXP, SEXP distanceSEXP) {
@@ -1110,6 +1433,28 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// cpp_s2_geography_store_write
+void cpp_s2_geography_store_write(List geog, std::string path);
+RcppExport SEXP _s2_cpp_s2_geography_store_write(SEXP geogSEXP, SEXP pathSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type geog(geogSEXP);
+    Rcpp::traits::input_parameter< std::string >::type path(pathSEXP);
+    cpp_s2_geography_store_write(geog, path);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_s2_geography_store_open
+List cpp_s2_geography_store_open(std::string path);
+RcppExport SEXP _s2_cpp_s2_geography_store_open(SEXP pathSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::string >::type path(pathSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_geography_store_open(path));
+    return rcpp_result_gen;
+END_RCPP
+}
 // cpp_s2_intersection
 List cpp_s2_intersection(List geog1, List geog2, List s2options);
 RcppExport SEXP _s2_cpp_s2_intersection(SEXP geog1SEXP, SEXP geog2SEXP, SEXP s2optionsSEXP) {
@@ -1214,26 +1559,28 @@ BEGIN_RCPP
 END_RCPP
 }
 // cpp_s2_closest_point
-List cpp_s2_closest_point(List geog1, List geog2);
-RcppExport SEXP _s2_cpp_s2_closest_point(SEXP geog1SEXP, SEXP geog2SEXP) {
+List cpp_s2_closest_point(List geog1, List geog2, NumericVector maxError);
+RcppExport SEXP _s2_cpp_s2_closest_point(SEXP geog1SEXP, SEXP geog2SEXP, SEXP maxErrorSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< List >::type geog1(geog1SEXP);
     Rcpp::traits::input_parameter< List >::type geog2(geog2SEXP);
-    rcpp_result_gen = Rcpp::wrap(cpp_s2_closest_point(geog1, geog2));
+    Rcpp::traits::input_parameter< NumericVector >::type maxError(maxErrorSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_closest_point(geog1, geog2, maxError));
     return rcpp_result_gen;
 END_RCPP
 }
 // cpp_s2_minimum_clearance_line_between
-List cpp_s2_minimum_clearance_line_between(List geog1, List geog2);
-RcppExport SEXP _s2_cpp_s2_minimum_clearance_line_between(SEXP geog1SEXP, SEXP geog2SEXP) {
+List cpp_s2_minimum_clearance_line_between(List geog1, List geog2, NumericVector maxError);
+RcppExport SEXP _s2_cpp_s2_minimum_clearance_line_between(SEXP geog1SEXP, SEXP geog2SEXP, SEXP maxErrorSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< List >::type geog1(geog1SEXP);
     Rcpp::traits::input_parameter< List >::type geog2(geog2SEXP);
-    rcpp_result_gen = Rcpp::wrap(cpp_s2_minimum_clearance_line_between(geog1, geog2));
+    Rcpp::traits::input_parameter< NumericVector >::type maxError(maxErrorSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_minimum_clearance_line_between(geog1, geog2, maxError));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -1294,15 +1641,32 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
-// cpp_s2_interpolate_normalized
-List cpp_s2_interpolate_normalized(List geog, NumericVector distanceNormalized);
-RcppExport SEXP _s2_cpp_s2_interpolate_normalized(SEXP geogSEXP, SEXP distanceNormalizedSEXP) {
+// cpp_s2_interpolate
+List cpp_s2_interpolate(List geog, NumericVector distance, bool normalized, int numThreads);
+RcppExport SEXP _s2_cpp_s2_interpolate(SEXP geogSEXP, SEXP distanceSEXP, SEXP normalizedSEXP, SEXP numThreadsSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< List >::type geog(geogSEXP);
-    Rcpp::traits::input_parameter< NumericVector >::type distanceNormalized(distanceNormalizedSEXP);
-    rcpp_result_gen = Rcpp::wrap(cpp_s2_interpolate_normalized(geog, distanceNormalized));
+    Rcpp::traits::input_parameter< NumericVector >::type distance(distanceSEXP);
+    Rcpp::traits::input_parameter< bool >::type normalized(normalizedSEXP);
+    Rcpp::traits::input_parameter< int >::type numThreads(numThreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_interpolate(geog, distance, normalized, numThreads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cpp_s2_substring
+List cpp_s2_substring(List geog, NumericVector start, NumericVector end, bool normalized, int numThreads);
+RcppExport SEXP _s2_cpp_s2_substring(SEXP geogSEXP, SEXP startSEXP, SEXP endSEXP, SEXP normalizedSEXP, SEXP numThreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type geog(geogSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type start(startSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type end(endSEXP);
+    Rcpp::traits::input_parameter< bool >::type normalized(normalizedSEXP);
+    Rcpp::traits::input_parameter< int >::type numThreads(numThreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_substring(geog, start, end, normalized, numThreads));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -1343,8 +1707,46 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// cpp_s2_medoid_polyline_agg
+List cpp_s2_medoid_polyline_agg(List geog, int method, bool naRm);
+RcppExport SEXP _s2_cpp_s2_medoid_polyline_agg(SEXP geogSEXP, SEXP methodSEXP, SEXP naRmSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type geog(geogSEXP);
+    Rcpp::traits::input_parameter< int >::type method(methodSEXP);
+    Rcpp::traits::input_parameter< bool >::type naRm(naRmSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_medoid_polyline_agg(geog, method, naRm));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cpp_s2_consensus_polyline_agg
+List cpp_s2_consensus_polyline_agg(List geog, int method, bool seedMedoid, int iterationCap, bool naRm);
+RcppExport SEXP _s2_cpp_s2_consensus_polyline_agg(SEXP geogSEXP, SEXP methodSEXP, SEXP seedMedoidSEXP, SEXP iterationCapSEXP, SEXP naRmSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type geog(geogSEXP);
+    Rcpp::traits::input_parameter< int >::type method(methodSEXP);
+    Rcpp::traits::input_parameter< bool >::type seedMedoid(seedMedoidSEXP);
+    Rcpp::traits::input_parameter< int >::type iterationCap(iterationCapSEXP);
+    Rcpp::traits::input_parameter< bool >::type naRm(naRmSEXP);
+    rcpp_result_gen = Rcpp::wrap(cpp_s2_consensus_polyline_agg(geog, method, seedMedoid, iterationCap, naRm));
+    return rcpp_result_gen;
+END_RCPP
+}
 
-RcppExport SEXP c_s2_geography_writer_new(SEXP, SEXP, SEXP, SEXP);
+RcppExport SEXP c_s2_geography_buffer_finish(SEXP, SEXP);
+RcppExport SEXP c_s2_geography_buffer_new(void);
+RcppExport SEXP c_s2_geography_buffer_size(SEXP);
+RcppExport SEXP c_s2_geography_from_geoarrow(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
+RcppExport SEXP c_s2_geography_from_wkb(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
+RcppExport SEXP c_s2_geography_serialize(SEXP, SEXP);
+RcppExport SEXP c_s2_geography_to_geoarrow(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
+RcppExport SEXP c_s2_geography_unserialize(SEXP, SEXP, SEXP);
+RcppExport SEXP c_s2_geography_writer_new(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
+RcppExport SEXP c_s2_handle_cell_polygon(SEXP, SEXP);
+RcppExport SEXP c_s2_handle_cell_polygon_tessellated(SEXP, SEXP);
 RcppExport SEXP c_s2_handle_geography(SEXP, SEXP);
 RcppExport SEXP c_s2_handle_geography_tessellated(SEXP, SEXP);
 RcppExport SEXP c_s2_projection_mercator(SEXP);
@@ -1361,26 +1763,35 @@ static const R_CallMethodDef CallEntries[] = {
     {"_s2_cpp_s2_dimension", (DL_FUNC) &_s2_cpp_s2_dimension, 1},
     {"_s2_cpp_s2_num_points", (DL_FUNC) &_s2_cpp_s2_num_points, 1},
     {"_s2_cpp_s2_is_empty", (DL_FUNC) &_s2_cpp_s2_is_empty, 1},
-    {"_s2_cpp_s2_area", (DL_FUNC) &_s2_cpp_s2_area, 1},
-    {"_s2_cpp_s2_length", (DL_FUNC) &_s2_cpp_s2_length, 1},
-    {"_s2_cpp_s2_perimeter", (DL_FUNC) &_s2_cpp_s2_perimeter, 1},
+    {"_s2_cpp_s2_area", (DL_FUNC) &_s2_cpp_s2_area, 3},
+    {"_s2_cpp_s2_length", (DL_FUNC) &_s2_cpp_s2_length, 3},
+    {"_s2_cpp_s2_perimeter", (DL_FUNC) &_s2_cpp_s2_perimeter, 3},
     {"_s2_cpp_s2_x", (DL_FUNC) &_s2_cpp_s2_x, 1},
     {"_s2_cpp_s2_y", (DL_FUNC) &_s2_cpp_s2_y, 1},
-    {"_s2_cpp_s2_project_normalized", (DL_FUNC) &_s2_cpp_s2_project_normalized, 2},
-    {"_s2_cpp_s2_distance", (DL_FUNC) &_s2_cpp_s2_distance, 2},
-    {"_s2_cpp_s2_max_distance", (DL_FUNC) &_s2_cpp_s2_max_distance, 2},
+    {"_s2_cpp_s2_project", (DL_FUNC) &_s2_cpp_s2_project, 4},
+    {"_s2_cpp_s2_distance", (DL_FUNC) &_s2_cpp_s2_distance, 3},
+    {"_s2_cpp_s2_max_distance", (DL_FUNC) &_s2_cpp_s2_max_distance, 3},
+    {"_s2_cpp_s2_hausdorff_distance", (DL_FUNC) &_s2_cpp_s2_hausdorff_distance, 5},
+    {"_s2_cpp_s2_alignment_cost", (DL_FUNC) &_s2_cpp_s2_alignment_cost, 4},
+    {"_s2_cpp_s2_distance_point_vector", (DL_FUNC) &_s2_cpp_s2_distance_point_vector, 3},
+    {"_s2_cpp_s2_max_distance_point_vector", (DL_FUNC) &_s2_cpp_s2_max_distance_point_vector, 3},
     {"_s2_cpp_s2_bounds_cap", (DL_FUNC) &_s2_cpp_s2_bounds_cap, 1},
     {"_s2_cpp_s2_bounds_rect", (DL_FUNC) &_s2_cpp_s2_bounds_rect, 1},
     {"_s2_cpp_s2_cell_union_normalize", (DL_FUNC) &_s2_cpp_s2_cell_union_normalize, 1},
     {"_s2_cpp_s2_cell_union_is_na", (DL_FUNC) &_s2_cpp_s2_cell_union_is_na, 1},
-    {"_s2_cpp_s2_cell_union_contains", (DL_FUNC) &_s2_cpp_s2_cell_union_contains, 2},
-    {"_s2_cpp_s2_cell_union_contains_cell", (DL_FUNC) &_s2_cpp_s2_cell_union_contains_cell, 2},
-    {"_s2_cpp_s2_cell_union_intersects", (DL_FUNC) &_s2_cpp_s2_cell_union_intersects, 2},
-    {"_s2_cpp_s2_cell_union_intersection", (DL_FUNC) &_s2_cpp_s2_cell_union_intersection, 2},
-    {"_s2_cpp_s2_cell_union_union", (DL_FUNC) &_s2_cpp_s2_cell_union_union, 2},
-    {"_s2_cpp_s2_cell_union_difference", (DL_FUNC) &_s2_cpp_s2_cell_union_difference, 2},
+    {"_s2_cpp_s2_cell_union_contains", (DL_FUNC) &_s2_cpp_s2_cell_union_contains, 3},
+    {"_s2_cpp_s2_cell_union_contains_cell", (DL_FUNC) &_s2_cpp_s2_cell_union_contains_cell, 3},
+    {"_s2_cpp_s2_cell_union_intersects", (DL_FUNC) &_s2_cpp_s2_cell_union_intersects, 3},
+    {"_s2_cpp_s2_cell_union_intersection", (DL_FUNC) &_s2_cpp_s2_cell_union_intersection, 3},
+    {"_s2_cpp_s2_cell_union_union", (DL_FUNC) &_s2_cpp_s2_cell_union_union, 3},
+    {"_s2_cpp_s2_cell_union_difference", (DL_FUNC) &_s2_cpp_s2_cell_union_difference, 3},
+    {"_s2_cpp_s2_cell_union_encode", (DL_FUNC) &_s2_cpp_s2_cell_union_encode, 1},
+    {"_s2_cpp_s2_cell_union_decode", (DL_FUNC) &_s2_cpp_s2_cell_union_decode, 1},
+    {"_s2_cpp_s2_cell_union_encoded_contains_cell", (DL_FUNC) &_s2_cpp_s2_cell_union_encoded_contains_cell, 2},
     {"_s2_cpp_s2_geography_from_cell_union", (DL_FUNC) &_s2_cpp_s2_geography_from_cell_union, 1},
     {"_s2_cpp_s2_covering_cell_ids", (DL_FUNC) &_s2_cpp_s2_covering_cell_ids, 6},
+    {"_s2_cpp_s2_covering_cell_ids_table", (DL_FUNC) &_s2_cpp_s2_covering_cell_ids_table, 7},
+    {"_s2_cpp_s2_covering_cell_ids_table_point_vector", (DL_FUNC) &_s2_cpp_s2_covering_cell_ids_table_point_vector, 4},
     {"_s2_cpp_s2_covering_cell_ids_agg", (DL_FUNC) &_s2_cpp_s2_covering_cell_ids_agg, 7},
     {"_s2_cpp_s2_cell_sentinel", (DL_FUNC) &_s2_cpp_s2_cell_sentinel, 0},
     {"_s2_cpp_s2_cell_from_string", (DL_FUNC) &_s2_cpp_s2_cell_from_string, 1},
@@ -1403,6 +1814,7 @@ static const R_CallMethodDef CallEntries[] = {
     {"_s2_cpp_s2_cell_parent", (DL_FUNC) &_s2_cpp_s2_cell_parent, 2},
     {"_s2_cpp_s2_cell_child", (DL_FUNC) &_s2_cpp_s2_cell_child, 2},
     {"_s2_cpp_s2_cell_edge_neighbour", (DL_FUNC) &_s2_cpp_s2_cell_edge_neighbour, 2},
+    {"_s2_cpp_s2_cell_neighbourhood", (DL_FUNC) &_s2_cpp_s2_cell_neighbourhood, 5},
     {"_s2_cpp_s2_cell_cummax", (DL_FUNC) &_s2_cpp_s2_cell_cummax, 1},
     {"_s2_cpp_s2_cell_cummin", (DL_FUNC) &_s2_cpp_s2_cell_cummin, 1},
     {"_s2_cpp_s2_cell_eq", (DL_FUNC) &_s2_cpp_s2_cell_eq, 2},
@@ -1417,11 +1829,18 @@ static const R_CallMethodDef CallEntries[] = {
     {"_s2_cpp_s2_cell_max_distance", (DL_FUNC) &_s2_cpp_s2_cell_max_distance, 2},
     {"_s2_cpp_s2_cell_common_ancestor_level", (DL_FUNC) &_s2_cpp_s2_cell_common_ancestor_level, 2},
     {"_s2_cpp_s2_cell_common_ancestor_level_agg", (DL_FUNC) &_s2_cpp_s2_cell_common_ancestor_level_agg, 1},
+    {"_s2_cpp_s2_cell_histogram", (DL_FUNC) &_s2_cpp_s2_cell_histogram, 4},
+    {"_s2_cpp_s2_cell_histogram_lnglat", (DL_FUNC) &_s2_cpp_s2_cell_histogram_lnglat, 4},
+    {"_s2_cpp_s2_cell_encode", (DL_FUNC) &_s2_cpp_s2_cell_encode, 1},
+    {"_s2_cpp_s2_cell_decode", (DL_FUNC) &_s2_cpp_s2_cell_decode, 2},
+    {"_s2_cpp_s2_cell_encoded_size", (DL_FUNC) &_s2_cpp_s2_cell_encoded_size, 1},
+    {"_s2_cpp_s2_cell_encoded_lower_bound", (DL_FUNC) &_s2_cpp_s2_cell_encoded_lower_bound, 2},
     {"_s2_s2_geography_full", (DL_FUNC) &_s2_s2_geography_full, 1},
     {"_s2_cpp_s2_geography_is_na", (DL_FUNC) &_s2_cpp_s2_geography_is_na, 1},
     {"_s2_s2_lnglat_from_s2_point", (DL_FUNC) &_s2_s2_lnglat_from_s2_point, 1},
     {"_s2_s2_point_from_s2_lnglat", (DL_FUNC) &_s2_s2_point_from_s2_lnglat, 1},
-    {"_s2_cpp_s2_closest_feature", (DL_FUNC) &_s2_cpp_s2_closest_feature, 2},
+    {"_s2_cpp_s2_closest_feature", (DL_FUNC) &_s2_cpp_s2_closest_feature, 3},
+    {"_s2_cpp_s2_closest_feature_point_vector", (DL_FUNC) &_s2_cpp_s2_closest_feature_point_vector, 3},
     {"_s2_cpp_s2_farthest_feature", (DL_FUNC) &_s2_cpp_s2_farthest_feature, 2},
     {"_s2_cpp_s2_closest_edges", (DL_FUNC) &_s2_cpp_s2_closest_edges, 5},
     {"_s2_cpp_s2_may_intersect_matrix", (DL_FUNC) &_s2_cpp_s2_may_intersect_matrix, 5},
@@ -1431,8 +1850,12 @@ static const R_CallMethodDef CallEntries[] = {
     {"_s2_cpp_s2_equals_matrix", (DL_FUNC) &_s2_cpp_s2_equals_matrix, 3},
     {"_s2_cpp_s2_touches_matrix", (DL_FUNC) &_s2_cpp_s2_touches_matrix, 3},
     {"_s2_cpp_s2_dwithin_matrix", (DL_FUNC) &_s2_cpp_s2_dwithin_matrix, 3},
-    {"_s2_cpp_s2_distance_matrix", (DL_FUNC) &_s2_cpp_s2_distance_matrix, 2},
-    {"_s2_cpp_s2_max_distance_matrix", (DL_FUNC) &_s2_cpp_s2_max_distance_matrix, 2},
+    {"_s2_cpp_s2_dwithin_matrix_point_vector", (DL_FUNC) &_s2_cpp_s2_dwithin_matrix_point_vector, 3},
+    {"_s2_cpp_s2_distance_matrix", (DL_FUNC) &_s2_cpp_s2_distance_matrix, 3},
+    {"_s2_cpp_s2_distance_matrix_point_vector", (DL_FUNC) &_s2_cpp_s2_distance_matrix_point_vector, 3},
+    {"_s2_cpp_s2_max_distance_matrix", (DL_FUNC) &_s2_cpp_s2_max_distance_matrix, 3},
+    {"_s2_cpp_s2_hausdorff_distance_matrix", (DL_FUNC) &_s2_cpp_s2_hausdorff_distance_matrix, 5},
+    {"_s2_cpp_s2_alignment_cost_matrix", (DL_FUNC) &_s2_cpp_s2_alignment_cost_matrix, 4},
     {"_s2_cpp_s2_contains_matrix_brute_force", (DL_FUNC) &_s2_cpp_s2_contains_matrix_brute_force, 3},
     {"_s2_cpp_s2_within_matrix_brute_force", (DL_FUNC) &_s2_cpp_s2_within_matrix_brute_force, 3},
     {"_s2_cpp_s2_intersects_matrix_brute_force", (DL_FUNC) &_s2_cpp_s2_intersects_matrix_brute_force, 3},
@@ -1443,9 +1866,13 @@ static const R_CallMethodDef CallEntries[] = {
     {"_s2_cpp_s2_equals", (DL_FUNC) &_s2_cpp_s2_equals, 3},
     {"_s2_cpp_s2_contains", (DL_FUNC) &_s2_cpp_s2_contains, 3},
     {"_s2_cpp_s2_touches", (DL_FUNC) &_s2_cpp_s2_touches, 3},
+    {"_s2_cpp_s2_relations", (DL_FUNC) &_s2_cpp_s2_relations, 4},
     {"_s2_cpp_s2_dwithin", (DL_FUNC) &_s2_cpp_s2_dwithin, 3},
+    {"_s2_cpp_s2_dwithin_point_vector", (DL_FUNC) &_s2_cpp_s2_dwithin_point_vector, 3},
     {"_s2_cpp_s2_prepared_dwithin", (DL_FUNC) &_s2_cpp_s2_prepared_dwithin, 3},
     {"_s2_cpp_s2_intersects_box", (DL_FUNC) &_s2_cpp_s2_intersects_box, 7},
+    {"_s2_cpp_s2_geography_store_write", (DL_FUNC) &_s2_cpp_s2_geography_store_write, 2},
+    {"_s2_cpp_s2_geography_store_open", (DL_FUNC) &_s2_cpp_s2_geography_store_open, 1},
     {"_s2_cpp_s2_intersection", (DL_FUNC) &_s2_cpp_s2_intersection, 3},
     {"_s2_cpp_s2_union", (DL_FUNC) &_s2_cpp_s2_union, 3},
     {"_s2_cpp_s2_difference", (DL_FUNC) &_s2_cpp_s2_difference, 3},
@@ -1454,25 +1881,38 @@ static const R_CallMethodDef CallEntries[] = {
     {"_s2_cpp_s2_union_agg", (DL_FUNC) &_s2_cpp_s2_union_agg, 3},
     {"_s2_cpp_s2_centroid_agg", (DL_FUNC) &_s2_cpp_s2_centroid_agg, 2},
     {"_s2_cpp_s2_rebuild_agg", (DL_FUNC) &_s2_cpp_s2_rebuild_agg, 3},
-    {"_s2_cpp_s2_closest_point", (DL_FUNC) &_s2_cpp_s2_closest_point, 2},
-    {"_s2_cpp_s2_minimum_clearance_line_between", (DL_FUNC) &_s2_cpp_s2_minimum_clearance_line_between, 2},
+    {"_s2_cpp_s2_closest_point", (DL_FUNC) &_s2_cpp_s2_closest_point, 3},
+    {"_s2_cpp_s2_minimum_clearance_line_between", (DL_FUNC) &_s2_cpp_s2_minimum_clearance_line_between, 3},
     {"_s2_cpp_s2_centroid", (DL_FUNC) &_s2_cpp_s2_centroid, 1},
     {"_s2_cpp_s2_point_on_surface", (DL_FUNC) &_s2_cpp_s2_point_on_surface, 1},
     {"_s2_cpp_s2_boundary", (DL_FUNC) &_s2_cpp_s2_boundary, 1},
     {"_s2_cpp_s2_rebuild", (DL_FUNC) &_s2_cpp_s2_rebuild, 2},
     {"_s2_cpp_s2_unary_union", (DL_FUNC) &_s2_cpp_s2_unary_union, 2},
-    {"_s2_cpp_s2_interpolate_normalized", (DL_FUNC) &_s2_cpp_s2_interpolate_normalized, 2},
+    {"_s2_cpp_s2_interpolate", (DL_FUNC) &_s2_cpp_s2_interpolate, 4},
+    {"_s2_cpp_s2_substring", (DL_FUNC) &_s2_cpp_s2_substring, 5},
     {"_s2_cpp_s2_buffer_cells", (DL_FUNC) &_s2_cpp_s2_buffer_cells, 4},
     {"_s2_cpp_s2_convex_hull", (DL_FUNC) &_s2_cpp_s2_convex_hull, 1},
     {"_s2_cpp_s2_convex_hull_agg", (DL_FUNC) &_s2_cpp_s2_convex_hull_agg, 2},
-    {"c_s2_geography_writer_new",         (DL_FUNC) &c_s2_geography_writer_new,         4},
-    {"c_s2_handle_geography",             (DL_FUNC) &c_s2_handle_geography,             2},
-    {"c_s2_handle_geography_tessellated", (DL_FUNC) &c_s2_handle_geography_tessellated, 2},
-    {"c_s2_projection_mercator",          (DL_FUNC) &c_s2_projection_mercator,          1},
-    {"c_s2_projection_orthographic",      (DL_FUNC) &c_s2_projection_orthographic,      1},
-    {"c_s2_projection_plate_carree",      (DL_FUNC) &c_s2_projection_plate_carree,      1},
-    {"c_s2_trans_s2_lnglat_new",          (DL_FUNC) &c_s2_trans_s2_lnglat_new,          0},
-    {"c_s2_trans_s2_point_new",           (DL_FUNC) &c_s2_trans_s2_point_new,           0},
+    {"_s2_cpp_s2_medoid_polyline_agg", (DL_FUNC) &_s2_cpp_s2_medoid_polyline_agg, 3},
+    {"_s2_cpp_s2_consensus_polyline_agg", (DL_FUNC) &_s2_cpp_s2_consensus_polyline_agg, 5},
+    {"c_s2_geography_buffer_finish",         (DL_FUNC) &c_s2_geography_buffer_finish,         2},
+    {"c_s2_geography_buffer_new",            (DL_FUNC) &c_s2_geography_buffer_new,            0},
+    {"c_s2_geography_buffer_size",           (DL_FUNC) &c_s2_geography_buffer_size,           1},
+    {"c_s2_geography_from_geoarrow",         (DL_FUNC) &c_s2_geography_from_geoarrow,         9},
+    {"c_s2_geography_from_wkb",              (DL_FUNC) &c_s2_geography_from_wkb,              7},
+    {"c_s2_geography_serialize",             (DL_FUNC) &c_s2_geography_serialize,             2},
+    {"c_s2_geography_to_geoarrow",           (DL_FUNC) &c_s2_geography_to_geoarrow,           6},
+    {"c_s2_geography_unserialize",           (DL_FUNC) &c_s2_geography_unserialize,           3},
+    {"c_s2_geography_writer_new",            (DL_FUNC) &c_s2_geography_writer_new,            7},
+    {"c_s2_handle_cell_polygon",             (DL_FUNC) &c_s2_handle_cell_polygon,             2},
+    {"c_s2_handle_cell_polygon_tessellated", (DL_FUNC) &c_s2_handle_cell_polygon_tessellated, 2},
+    {"c_s2_handle_geography",                (DL_FUNC) &c_s2_handle_geography,                2},
+    {"c_s2_handle_geography_tessellated",    (DL_FUNC) &c_s2_handle_geography_tessellated,    2},
+    {"c_s2_projection_mercator",             (DL_FUNC) &c_s2_projection_mercator,             1},
+    {"c_s2_projection_orthographic",         (DL_FUNC) &c_s2_projection_orthographic,         1},
+    {"c_s2_projection_plate_carree",         (DL_FUNC) &c_s2_projection_plate_carree,         1},
+    {"c_s2_trans_s2_lnglat_new",             (DL_FUNC) &c_s2_trans_s2_lnglat_new,             0},
+    {"c_s2_trans_s2_point_new",              (DL_FUNC) &c_s2_trans_s2_point_new,              0},
     {NULL, NULL, 0}
 };
 
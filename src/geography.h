@@ -2,6 +2,9 @@
 #ifndef GEOGRAPHY_H
 #define GEOGRAPHY_H
 
+#include <algorithm>
+#include <vector>
+
 #include <Rcpp.h>
 
 #include "s2geography.h"
@@ -11,18 +14,64 @@ public:
   RGeography(std::unique_ptr<s2geography::Geography> geog):
     geog_(std::move(geog)), index_(nullptr) {}
 
+  RGeography(std::unique_ptr<s2geography::Geography> geog,
+             std::unique_ptr<s2geography::ShapeIndexGeography> index):
+    geog_(std::move(geog)), index_(std::move(index)) {}
+
   const s2geography::Geography& Geog() const {
     return *geog_;
   }
 
+  // Geographies backed by an encoded shape index (e.g., features of a
+  // geography store) use that index instead of building a new one
   const s2geography::ShapeIndexGeography& Index() {
     if (!index_) {
-      this->index_ = absl::make_unique<s2geography::ShapeIndexGeography>(*geog_);
+      auto encoded = s2geography::geography_cast<s2geography::EncodedShapeIndexGeography>(geog_.get());
+      if (encoded != nullptr) {
+        this->index_ = absl::make_unique<s2geography::ShapeIndexGeography>(*encoded);
+      } else {
+        this->index_ = absl::make_unique<s2geography::ShapeIndexGeography>(*geog_);
+      }
     }
 
     return *index_;
   }
 
+  // The rectangle bound of the geography, computed on first use. This is
+  // much cheaper to compute and to keep than Index() and is enough to
+  // resolve many predicates against a box.
+  const S2LatLngRect& RectBound() {
+    if (!rect_bound_) {
+      this->rect_bound_ = absl::make_unique<S2LatLngRect>(geog_->Region()->GetRectBound());
+    }
+
+    return *rect_bound_;
+  }
+
+  // The indexes of the features of a geography vector, or nullptr for
+  // missing and empty features. Index() builds an index on first use and
+  // can't be called from a worker thread, so the indexes are collected on
+  // the main thread before a parallel loop.
+  static std::vector<const s2geography::ShapeIndexGeography*> NonEmptyIndexes(Rcpp::List geog) {
+    std::vector<const s2geography::ShapeIndexGeography*> indexes(geog.size());
+    for (R_xlen_t i = 0; i < geog.size(); i++) {
+      SEXP item = geog[i];
+      if (item == R_NilValue) {
+        indexes[i] = nullptr;
+        continue;
+      }
+
+      RGeography* feature = reinterpret_cast<RGeography*>(R_ExternalPtrAddr(item));
+      if (s2geography::s2_is_empty(feature->Geog())) {
+        indexes[i] = nullptr;
+      } else {
+        indexes[i] = &feature->Index();
+      }
+    }
+
+    return indexes;
+  }
+
   // For an unknown reason, returning a SEXP from MakeXPtr results in
   // rchk reporting a memory protection error. Until this is sorted, return a
   // Rcpp::XPtr<>() (even though this might be slower)
@@ -77,6 +126,7 @@ public:
 private:
   std::unique_ptr<s2geography::Geography> geog_;
   std::unique_ptr<s2geography::ShapeIndexGeography> index_;
+  std::unique_ptr<S2LatLngRect> rect_bound_;
 
   static void finalize_xptr(SEXP xptr) {
     RGeography* geog = reinterpret_cast<RGeography*>(R_ExternalPtrAddr(xptr));
@@ -86,4 +136,69 @@ private:
   }
 };
 
+// Bulk imports can optionally allocate the RGeography objects for a whole
+// vector from a shared block (a few large chunks) instead of one at a time.
+// The block is owned by an external pointer that is the "protected" value of
+// each feature's external pointer: features don't need a finalizer of their
+// own and the block (and every feature in it) is freed at once when the last
+// feature referring to it is garbage collected. Because a single feature keeps
+// the whole block alive, this is opt-in. Only the RGeography objects live in
+// the block: the Geography each of them owns (and its S2 geometry) is still
+// allocated separately by the importers.
+class RGeographyBlock {
+public:
+  explicit RGeographyBlock(R_xlen_t size_hint):
+    next_chunk_size_(std::max<R_xlen_t>(size_hint, kMinChunkSize)) {}
+
+  template <typename... Args>
+  RGeography* Make(Args&&... args) {
+    if (chunks_.empty() || chunks_.back().size() == chunks_.back().capacity()) {
+      chunks_.emplace_back();
+      chunks_.back().reserve(next_chunk_size_);
+      next_chunk_size_ = std::min<R_xlen_t>(next_chunk_size_ * 2, kMaxChunkSize);
+    }
+
+    chunks_.back().emplace_back(std::forward<Args>(args)...);
+    return &chunks_.back().back();
+  }
+
+  RGeography* Make(std::unique_ptr<RGeography> geog) {
+    return Make(std::move(*geog));
+  }
+
+  // Returns an (unprotected) external pointer that owns a new block
+  static SEXP MakeXPtr(R_xlen_t size_hint) {
+    SEXP block_xptr = PROTECT(R_MakeExternalPtr(new RGeographyBlock(size_hint), R_NilValue, R_NilValue));
+    R_RegisterCFinalizer(block_xptr, &finalize_xptr);
+    UNPROTECT(1);
+    return block_xptr;
+  }
+
+  // Returns an (unprotected) external pointer to a feature allocated from
+  // the block owned by block_xptr
+  template <typename T>
+  static SEXP MakeFeatureXPtr(SEXP block_xptr, std::unique_ptr<T> geog) {
+    auto block = reinterpret_cast<RGeographyBlock*>(R_ExternalPtrAddr(block_xptr));
+    RGeography* feature = block->Make(std::move(geog));
+    return R_MakeExternalPtr(feature, R_NilValue, block_xptr);
+  }
+
+private:
+  static const R_xlen_t kMinChunkSize = 1024;
+  static const R_xlen_t kMaxChunkSize = 1048576;
+
+  // chunks never grow past their reserved capacity, so pointers to their
+  // elements remain valid
+  std::vector<std::vector<RGeography>> chunks_;
+  R_xlen_t next_chunk_size_;
+
+  static void finalize_xptr(SEXP xptr) {
+    auto block = reinterpret_cast<RGeographyBlock*>(R_ExternalPtrAddr(xptr));
+    if (block != nullptr) {
+      delete block;
+      R_ClearExternalPtr(xptr);
+    }
+  }
+};
+
 #endif
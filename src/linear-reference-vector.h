@@ -0,0 +1,107 @@
+
+#ifndef LINEAR_REFERENCE_VECTOR_H
+#define LINEAR_REFERENCE_VECTOR_H
+
+#include <unordered_map>
+
+#include "geography.h"
+#include "s2-parallel.h"
+#include <Rcpp.h>
+
+// Prepared linear references for the features of a (recycled) geography
+// vector. Linear referencing queries usually pair many points or distances
+// with one polyline (or with a few polylines repeated many times), so each
+// distinct feature is prepared once and shared by every element that refers
+// to it. If requested, the edges of features that are used more than once
+// are indexed so that projection doesn't have to check every edge.
+// Preparation and queries don't use the R API and can run on worker threads.
+class LinearReferenceVector {
+public:
+  LinearReferenceVector(Rcpp::List geog, bool index, int numThreads):
+    features_(geog.size()), references_(geog.size(), nullptr) {
+    std::unordered_map<const s2geography::Geography*, size_t> referenceId;
+    std::vector<const s2geography::Geography*> distinct;
+    std::vector<size_t> uses;
+    std::vector<size_t> featureReference(geog.size());
+
+    for (R_xlen_t i = 0; i < geog.size(); i++) {
+      SEXP item = geog[i];
+      if (item == R_NilValue) {
+        features_[i] = nullptr;
+        continue;
+      }
+
+      features_[i] = &reinterpret_cast<RGeography*>(R_ExternalPtrAddr(item))->Geog();
+      auto inserted = referenceId.insert({features_[i], distinct.size()});
+      if (inserted.second) {
+        distinct.push_back(features_[i]);
+        uses.push_back(0);
+      }
+
+      featureReference[i] = inserted.first->second;
+      uses[featureReference[i]]++;
+    }
+
+    distinct_.resize(distinct.size());
+    s2_parallel_for(distinct.size(), numThreads, [&](int threadId, int64_t begin, int64_t end) {
+      for (int64_t j = begin; j < end; j++) {
+        auto reference = absl::make_unique<s2geography::LinearReference>();
+        if (!reference->Init(*distinct[j])) {
+          continue;
+        }
+
+        if (index && uses[j] > 1) {
+          reference->BuildIndex();
+        }
+
+        distinct_[j] = std::move(reference);
+      }
+    });
+
+    for (R_xlen_t i = 0; i < geog.size(); i++) {
+      if (features_[i] != nullptr) {
+        references_[i] = distinct_[featureReference[i]].get();
+      }
+    }
+  }
+
+  R_xlen_t size() const {
+    return features_.size();
+  }
+
+  // nullptr if the feature is NULL
+  const s2geography::Geography* feature(R_xlen_t i) const {
+    return features_[i];
+  }
+
+  // nullptr if the feature is NULL or is not a single polyline
+  const s2geography::LinearReference* reference(R_xlen_t i) const {
+    return references_[i];
+  }
+
+  // Errors encountered on worker threads are recorded per element and
+  // reported the same way as for a GeographyOperator
+  static void stopProblems(const std::vector<const char*>& problems) {
+    Rcpp::IntegerVector problemId;
+    Rcpp::CharacterVector problemMessage;
+    for (size_t i = 0; i < problems.size(); i++) {
+      if (problems[i] != nullptr) {
+        problemId.push_back(i);
+        problemMessage.push_back(problems[i]);
+      }
+    }
+
+    if (problemId.size() > 0) {
+      Rcpp::Environment s2NS = Rcpp::Environment::namespace_env("s2");
+      Rcpp::Function stopProblems = s2NS["stop_problems_process"];
+      stopProblems(problemId, problemMessage);
+    }
+  }
+
+private:
+  std::vector<const s2geography::Geography*> features_;
+  std::vector<std::unique_ptr<s2geography::LinearReference>> distinct_;
+  std::vector<const s2geography::LinearReference*> references_;
+};
+
+#endif
@@ -0,0 +1,51 @@
+
+#ifndef POINT_VECTOR_H
+#define POINT_VECTOR_H
+
+#include <cmath>
+
+#include "s2/s2point.h"
+
+#include <Rcpp.h>
+
+// A point vector is a columnar vector of single points: the x, y, and z
+// fields of an s2_point() (or an s2_lnglat() converted to unit vectors).
+// Points whose coordinates are NaN are empty (this is how wk represents
+// POINT EMPTY in an xy vector). Functions with a point vector code path
+// read coordinates from these columns rather than creating a geography (and
+// a shape index) for each point.
+class PointVector {
+public:
+  PointVector(Rcpp::List xyz):
+    x_(xyz[0]), y_(xyz[1]), z_(xyz[2]) {
+    if (y_.size() != x_.size() || z_.size() != x_.size()) {
+      Rcpp::stop("Point vector columns must have the same length"); // #nocov
+    }
+  }
+
+  R_xlen_t size() const {
+    return x_.size();
+  }
+
+  bool is_empty(R_xlen_t i) const {
+    return std::isnan(x_[i]) || std::isnan(y_[i]) || std::isnan(z_[i]);
+  }
+
+  S2Point point(R_xlen_t i) const {
+    return S2Point(x_[i], y_[i], z_[i]);
+  }
+
+  // Geography arguments that are paired with a point vector are recycled
+  // by the caller but keep their class so that they can be distinguished
+  // from point vector columns
+  static bool is_geography(SEXP x) {
+    return Rf_inherits(x, "s2_geography");
+  }
+
+private:
+  Rcpp::NumericVector x_;
+  Rcpp::NumericVector y_;
+  Rcpp::NumericVector z_;
+};
+
+#endif
@@ -1,5 +1,11 @@
 
+#include "s2/s2closest_edge_query.h"
+#include "s2/s2furthest_edge_query.h"
+
 #include "geography-operator.h"
+#include "linear-reference-vector.h"
+#include "point-vector.h"
+#include "s2-parallel.h"
 #include <Rcpp.h>
 using namespace Rcpp;
 
@@ -83,40 +89,98 @@ LogicalVector cpp_s2_is_empty(List geog) {
   return op.processVector(geog);
 }
 
-// [[Rcpp::export]]
-NumericVector cpp_s2_area(List geog) {
-  class Op: public UnaryGeographyOperator<NumericVector, double> {
-    double processFeature(XPtr<RGeography> feature, R_xlen_t i) {
-      return s2geography::s2_area(feature->Geog());
+// Measures are computed on worker threads: features are collected on the
+// main thread because the R API can't be used from a worker. With a single
+// thread, features are measured on the main thread so that the loop can be
+// interrupted. Errors are recorded by feature and reported the same way as
+// for a GeographyOperator.
+template <typename Measure>
+NumericVector measure_geography(List geog, int numThreads, Measure measure) {
+  R_xlen_t size = geog.size();
+  std::vector<const s2geography::Geography*> features(size);
+  for (R_xlen_t i = 0; i < size; i++) {
+    SEXP item = geog[i];
+    if (item == R_NilValue) {
+      features[i] = nullptr;
+    } else {
+      features[i] = &reinterpret_cast<RGeography*>(R_ExternalPtrAddr(item))->Geog();
     }
-  };
+  }
 
-  Op op;
-  return op.processVector(geog);
-}
+  NumericVector output(size);
+  double* outputPtr = REAL(output);
+  std::vector<std::string> problems(size);
 
-// [[Rcpp::export]]
-NumericVector cpp_s2_length(List geog) {
-  class Op: public UnaryGeographyOperator<NumericVector, double> {
-    double processFeature(XPtr<RGeography> feature, R_xlen_t i) {
-      return s2geography::s2_length(feature->Geog());
+  auto measureFeature = [&](int64_t i) {
+    if (features[i] == nullptr) {
+      outputPtr[i] = NA_REAL;
+      return;
+    }
+
+    try {
+      outputPtr[i] = measure(*features[i]);
+    } catch (std::exception& e) {
+      outputPtr[i] = NA_REAL;
+      problems[i] = e.what();
     }
   };
 
-  Op op;
-  return op.processVector(geog);
+  if (s2_parallel_num_threads(numThreads, size) == 1) {
+    for (R_xlen_t i = 0; i < size; i++) {
+      checkUserInterrupt();
+      measureFeature(i);
+    }
+  } else {
+    s2_parallel_for(size, numThreads, [&](int threadId, int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; i++) {
+        measureFeature(i);
+      }
+    });
+  }
+
+  IntegerVector problemId;
+  CharacterVector problemMessage;
+  for (R_xlen_t i = 0; i < size; i++) {
+    if (!problems[i].empty()) {
+      problemId.push_back(i);
+      problemMessage.push_back(problems[i]);
+    }
+  }
+
+  if (problemId.size() > 0) {
+    Environment s2NS = Environment::namespace_env("s2");
+    Function stopProblems = s2NS["stop_problems_process"];
+    stopProblems(problemId, problemMessage);
+  }
+
+  return output;
 }
 
 // [[Rcpp::export]]
-NumericVector cpp_s2_perimeter(List geog) {
-  class Op: public UnaryGeographyOperator<NumericVector, double> {
-    double processFeature(XPtr<RGeography> feature, R_xlen_t i) {
-      return s2geography::s2_perimeter(feature->Geog());
-    }
-  };
+NumericVector cpp_s2_area(List geog, bool approx, int numThreads) {
+  if (approx) {
+    return measure_geography(geog, numThreads, s2geography::s2_area_approx);
+  } else {
+    return measure_geography(geog, numThreads, s2geography::s2_area);
+  }
+}
 
-  Op op;
-  return op.processVector(geog);
+// [[Rcpp::export]]
+NumericVector cpp_s2_length(List geog, bool approx, int numThreads) {
+  if (approx) {
+    return measure_geography(geog, numThreads, s2geography::s2_length_approx);
+  } else {
+    return measure_geography(geog, numThreads, s2geography::s2_length);
+  }
+}
+
+// [[Rcpp::export]]
+NumericVector cpp_s2_perimeter(List geog, bool approx, int numThreads) {
+  if (approx) {
+    return measure_geography(geog, numThreads, s2geography::s2_perimeter_approx);
+  } else {
+    return measure_geography(geog, numThreads, s2geography::s2_perimeter);
+  }
 }
 
 // [[Rcpp::export]]
@@ -152,27 +216,55 @@ NumericVector cpp_s2_y(List geog) {
 }
 
 // [[Rcpp::export]]
-NumericVector cpp_s2_project_normalized(List geog1, List geog2) {
-  class Op: public BinaryGeographyOperator<NumericVector, double> {
-    double processFeature(XPtr<RGeography> feature1,
-                          XPtr<RGeography> feature2,
-                          R_xlen_t i) {
-      return s2geography::s2_project_normalized(feature1->Geog(), feature2->Geog());
+NumericVector cpp_s2_project(List geog1, List geog2, bool normalized, int numThreads) {
+  if (geog2.size() != geog1.size()) {
+    Rcpp::stop("Incompatible lengths");
+  }
+
+  LinearReferenceVector lines(geog1, true, numThreads);
+  std::vector<const s2geography::Geography*> points(geog2.size());
+  for (R_xlen_t i = 0; i < geog2.size(); i++) {
+    SEXP item = geog2[i];
+    if (item == R_NilValue) {
+      points[i] = nullptr;
+    } else {
+      points[i] = &reinterpret_cast<RGeography*>(R_ExternalPtrAddr(item))->Geog();
     }
-  };
+  }
 
-  Op op;
-  return op.processVector(geog1, geog2);
+  NumericVector output(lines.size());
+  double* outputPtr = REAL(output);
+
+  s2_parallel_for(lines.size(), numThreads, [&](int threadId, int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      if (lines.feature(i) == nullptr || points[i] == nullptr) {
+        outputPtr[i] = NA_REAL;
+      } else if (lines.reference(i) == nullptr) {
+        outputPtr[i] = NAN;
+      } else {
+        const s2geography::LinearReference* reference = lines.reference(i);
+        outputPtr[i] = reference->Project(*points[i]);
+        if (!normalized) {
+          outputPtr[i] *= reference->length();
+        }
+      }
+    }
+  });
+
+  return output;
 }
 
 // [[Rcpp::export]]
-NumericVector cpp_s2_distance(List geog1, List geog2) {
+NumericVector cpp_s2_distance(List geog1, List geog2, NumericVector maxError) {
   class Op: public BinaryGeographyOperator<NumericVector, double> {
+  public:
+    Op(NumericVector maxError): maxError(maxError) {}
 
     double processFeature(XPtr<RGeography> feature1,
                           XPtr<RGeography> feature2,
                           R_xlen_t i) {
-      double distance = s2geography::s2_distance(feature1->Index(), feature2->Index());
+      query.set_max_error(maxError[i]);
+      double distance = query.Distance(feature1->Index(), feature2->Index());
 
       if (distance == R_PosInf) {
         return NA_REAL;
@@ -180,20 +272,28 @@ NumericVector cpp_s2_distance(List geog1, List geog2) {
         return distance;
       }
     }
+
+  private:
+    NumericVector maxError;
+    // reuses the query and target if consecutive pairs share a feature
+    s2geography::PairwiseDistance query;
   };
 
-  Op op;
+  Op op(maxError);
   return op.processVector(geog1, geog2);
 }
 
 // [[Rcpp::export]]
-NumericVector cpp_s2_max_distance(List geog1, List geog2) {
+NumericVector cpp_s2_max_distance(List geog1, List geog2, NumericVector maxError) {
   class Op: public BinaryGeographyOperator<NumericVector, double> {
+  public:
+    Op(NumericVector maxError): maxError(maxError) {}
 
     double processFeature(XPtr<RGeography> feature1,
                           XPtr<RGeography> feature2,
                           R_xlen_t i) {
-      double distance = s2geography::s2_max_distance(feature1->Index(), feature2->Index());
+      query.set_max_error(maxError[i]);
+      double distance = query.MaxDistance(feature1->Index(), feature2->Index());
 
       // returns -1 if one of the indexes is empty
       // NA is more consistent with the BigQuery
@@ -204,8 +304,143 @@ NumericVector cpp_s2_max_distance(List geog1, List geog2) {
         return distance;
       }
     }
+
+  private:
+    NumericVector maxError;
+    s2geography::PairwiseMaxDistance query;
   };
 
-  Op op;
+  Op op(maxError);
   return op.processVector(geog1, geog2);
 }
+
+// Distances from each point of a point vector to the corresponding point
+// or geography in y. Queries are reused for consecutive points that are
+// paired with the same geography (e.g., if y was recycled from a single
+// feature), so each point only requires a PointTarget.
+template <typename QueryType>
+NumericVector point_vector_distance(List x, List y, NumericVector maxError) {
+  PointVector points(x);
+  NumericVector output(points.size());
+
+  if (PointVector::is_geography(y)) {
+    RGeography* last_feature = nullptr;
+    std::unique_ptr<QueryType> query;
+
+    for (R_xlen_t i = 0; i < points.size(); i++) {
+      if ((i % 1000) == 0) {
+        checkUserInterrupt();
+      }
+
+      SEXP item = y[i];
+      if (item == R_NilValue || points.is_empty(i)) {
+        output[i] = NA_REAL;
+        continue;
+      }
+
+      XPtr<RGeography> feature(item);
+      if (feature.get() != last_feature) {
+        query = absl::make_unique<QueryType>(&feature->Index().ShapeIndex());
+        last_feature = feature.get();
+      }
+
+      query->mutable_options()->set_max_error(S1Angle::Radians(maxError[i]));
+
+      // an empty index results in Infinity() or Negative()
+      typename QueryType::PointTarget target(points.point(i));
+      S1ChordAngle distance = query->GetDistance(&target);
+      if (distance.is_special()) {
+        output[i] = NA_REAL;
+      } else {
+        output[i] = distance.ToAngle().radians();
+      }
+    }
+  } else {
+    PointVector other(y);
+    for (R_xlen_t i = 0; i < points.size(); i++) {
+      if (points.is_empty(i) || other.is_empty(i)) {
+        output[i] = NA_REAL;
+      } else {
+        output[i] = S1ChordAngle(points.point(i), other.point(i)).ToAngle().radians();
+      }
+    }
+  }
+
+  return output;
+}
+
+// [[Rcpp::export]]
+NumericVector cpp_s2_hausdorff_distance(List geog1, List geog2, bool directed,
+                                        NumericVector maxDistance, int numThreads) {
+  if (geog2.size() != geog1.size()) {
+    Rcpp::stop("Incompatible lengths");
+  }
+
+  std::vector<const s2geography::ShapeIndexGeography*> index1 = RGeography::NonEmptyIndexes(geog1);
+  std::vector<const s2geography::ShapeIndexGeography*> index2 = RGeography::NonEmptyIndexes(geog2);
+
+  const double* maxDistancePtr = REAL(maxDistance);
+  NumericVector output(geog1.size());
+  double* outputPtr = REAL(output);
+
+  s2_parallel_for(geog1.size(), numThreads, [&](int threadId, int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      if (index1[i] == nullptr || index2[i] == nullptr || ISNAN(maxDistancePtr[i])) {
+        outputPtr[i] = NA_REAL;
+      } else if (directed) {
+        outputPtr[i] = s2geography::s2_directed_hausdorff_distance(
+          *index1[i], *index2[i], maxDistancePtr[i]
+        );
+      } else {
+        outputPtr[i] = s2geography::s2_hausdorff_distance(
+          *index1[i], *index2[i], maxDistancePtr[i]
+        );
+      }
+    }
+  });
+
+  return output;
+}
+
+// [[Rcpp::export]]
+NumericVector cpp_s2_alignment_cost(List geog1, List geog2, int method, int numThreads) {
+  if (geog2.size() != geog1.size()) {
+    Rcpp::stop("Incompatible lengths");
+  }
+
+  auto alignmentMethod = static_cast<s2geography::AlignmentMethod>(method);
+  LinearReferenceVector lines1(geog1, false, numThreads);
+  LinearReferenceVector lines2(geog2, false, numThreads);
+
+  NumericVector output(lines1.size());
+  double* outputPtr = REAL(output);
+
+  s2_parallel_for(lines1.size(), numThreads, [&](int threadId, int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      const s2geography::LinearReference* reference1 = lines1.reference(i);
+      const s2geography::LinearReference* reference2 = lines2.reference(i);
+      if (lines1.feature(i) == nullptr || lines2.feature(i) == nullptr) {
+        outputPtr[i] = NA_REAL;
+      } else if (reference1 == nullptr || reference2 == nullptr ||
+                 reference1->is_empty() || reference2->is_empty()) {
+        outputPtr[i] = NAN;
+      } else {
+        outputPtr[i] = s2geography::s2_alignment_cost(
+          reference1->polyline(), reference2->polyline(), alignmentMethod
+        );
+      }
+    }
+  });
+
+  return output;
+}
+
+// [[Rcpp::export]]
+NumericVector cpp_s2_distance_point_vector(List x, List y, NumericVector maxError) {
+  return point_vector_distance<S2ClosestEdgeQuery>(x, y, maxError);
+}
+
+// [[Rcpp::export]]
+NumericVector cpp_s2_max_distance_point_vector(List x, List y, NumericVector maxError) {
+  return point_vector_distance<S2FurthestEdgeQuery>(x, y, maxError);
+}
@@ -6,8 +6,10 @@
 #include "s2/s2region_coverer.h"
 #include "s2/s2shape_index_buffered_region.h"
 #include "s2/s2region_union.h"
+#include "s2/encoded_s2cell_id_vector.h"
 
 #include "geography-operator.h"
+#include "s2-parallel.h"
 
 #include <Rcpp.h>
 using namespace Rcpp;
@@ -19,10 +21,53 @@ static inline double reinterpret_double(uint64_t id) {
   return doppelganger;
 }
 
+// Same as the (private) check used by S2CellUnion::IsNormalized()
+static inline bool cell_ids_are_siblings(S2CellId a, S2CellId b, S2CellId c, S2CellId d) {
+  if ((a.id() ^ b.id() ^ c.id()) != d.id()) return false;
+
+  uint64 mask = d.lsb() << 1;
+  mask = ~(mask + (mask << 1));
+  uint64 id_masked = (d.id() & mask);
+  return ((a.id() & mask) == id_masked &&
+          (b.id() & mask) == id_masked &&
+          (c.id() & mask) == id_masked &&
+          !d.is_face());
+}
+
+static bool cell_ids_are_normalized(const std::vector<S2CellId>& cellIds) {
+  if (cellIds.size() > 0 && !cellIds[0].is_valid()) return false;
+  for (size_t i = 1; i < cellIds.size(); i++) {
+    if (!cellIds[i].is_valid()) return false;
+    if (cellIds[i - 1].range_max() >= cellIds[i].range_min()) return false;
+    if (i >= 3 && cell_ids_are_siblings(cellIds[i - 3], cellIds[i - 2],
+                                        cellIds[i - 1], cellIds[i])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Cell unions created by this package are already normalized, and checking
+// this (which is linear) is much faster than normalizing (which sorts).
+// This is safe to call from any thread.
+S2CellUnion cell_union_from_cell_ids(const uint64_t* cellIds, R_xlen_t size) {
+  std::vector<S2CellId> cellIdsVector;
+  cellIdsVector.reserve(size);
+  for (R_xlen_t i = 0; i < size; i++) {
+    cellIdsVector.emplace_back(cellIds[i]);
+  }
+
+  if (cell_ids_are_normalized(cellIdsVector)) {
+    return S2CellUnion::FromNormalized(std::move(cellIdsVector));
+  } else {
+    return S2CellUnion(std::move(cellIdsVector));
+  }
+}
+
 S2CellUnion cell_union_from_cell_id_vector(const NumericVector& cellIdNumeric) {
-  uint64* cellIds = (uint64*) &(cellIdNumeric[0]);
-  std::vector<S2CellId> cellIdsVector(cellIds, cellIds + cellIdNumeric.size());
-  return S2CellUnion(std::move(cellIdsVector));
+  const uint64_t* cellIds = (const uint64_t*) REAL(cellIdNumeric);
+  return cell_union_from_cell_ids(cellIds, cellIdNumeric.size());
 }
 
 NumericVector cell_id_vector_from_cell_union(const S2CellUnion& cellUnion) {
@@ -69,114 +114,127 @@ public:
   virtual ScalarType processCell(S2CellUnion& cellUnion, R_xlen_t i) = 0;
 };
 
+// A pointer to the cells of one element of an s2_cell_union() vector that
+// can be accessed from any thread
+struct CellUnionItem {
+  const uint64_t* cellIds;
+  R_xlen_t size;
+  bool isNull;
+};
+
+static std::vector<CellUnionItem> cell_union_items(const List& cellUnionVector) {
+  std::vector<CellUnionItem> items(cellUnionVector.size());
+  for (R_xlen_t i = 0; i < cellUnionVector.size(); i++) {
+    SEXP item = cellUnionVector[i];
+    if (item == R_NilValue) {
+      items[i] = {nullptr, 0, true};
+    } else {
+      items[i] = {(const uint64_t*) REAL(item), Rf_xlength(item), false};
+    }
+  }
+
+  return items;
+}
+
+static inline int cell_union_operator_output(int value) {
+  return value;
+}
+
+static inline SEXP cell_union_operator_output(const S2CellUnion& value) {
+  return cell_id_vector_from_cell_union(value);
+}
+
 // For speed, take care of recycling here (only works if there is no
 // additional parameter). Most binary ops don't have a parameter and some
-// (like Ops, and Math) make recycling harder to incorporate at the R level
+// (like Ops, and Math) make recycling harder to incorporate at the R level.
+// A recycled (length 1) side is only converted to an S2CellUnion once.
+// processCell() must return a C++ value (int or S2CellUnion) because it
+// may be called from more than one thread; values are converted
+// to R objects after all rows have been computed.
 template<class VectorType, class ScalarType>
 class BinaryS2CellUnionOperator {
 public:
+  BinaryS2CellUnionOperator(): numThreads(1) {}
+
   VectorType processVector(Rcpp::List cellUnionVector1,
                            Rcpp::List cellUnionVector2) {
+    R_xlen_t size1 = cellUnionVector1.size();
+    R_xlen_t size2 = cellUnionVector2.size();
 
-    SEXP item1 = R_NilValue;
-    SEXP item2 = R_NilValue;
-
-    if (cellUnionVector1.size() == cellUnionVector2.size()) {
-      VectorType output(cellUnionVector1.size());
+    if (size1 != size2 && size1 != 1 && size2 != 1) {
+      std::stringstream err;
+      err <<
+        "Can't recycle vectors of size " << size1 <<
+        " and " << size2 <<
+        " to a common length.";
+      stop(err.str());
+    }
 
-      for (R_xlen_t i = 0; i < cellUnionVector1.size(); i++) {
-        if ((i % 1000) == 0) {
-          Rcpp::checkUserInterrupt();
-        }
+    R_xlen_t size = (size1 == 1) ? size2 : size1;
+    std::vector<CellUnionItem> items1 = cell_union_items(cellUnionVector1);
+    std::vector<CellUnionItem> items2 = cell_union_items(cellUnionVector2);
 
-        item1 = cellUnionVector1[i];
-        item2 = cellUnionVector2[i];
+    S2CellUnion recycled1;
+    if (size1 == 1 && !items1[0].isNull) {
+      recycled1 = cell_union_from_cell_ids(items1[0].cellIds, items1[0].size);
+    }
 
-        if (item1 == R_NilValue || item2 == R_NilValue) {
-          output[i] = VectorType::get_na();
-        } else {
-          S2CellUnion cellUnion1 = cell_union_from_cell_id_vector(item1);
-          S2CellUnion cellUnion2 = cell_union_from_cell_id_vector(item2);
-          output[i] = this->processCell(cellUnion1, cellUnion2, i);
-        }
-      }
+    S2CellUnion recycled2;
+    if (size2 == 1 && !items2[0].isNull) {
+      recycled2 = cell_union_from_cell_ids(items2[0].cellIds, items2[0].size);
+    }
 
-      return output;
-    } else if (cellUnionVector1.size() == 1) {
-      VectorType output(cellUnionVector2.size());
-
-      item1 = cellUnionVector1[0];
-      if (item1 == R_NilValue) {
-        for (R_xlen_t i = 0; i < cellUnionVector2.size(); i++) {
-          if ((i % 1000) == 0) {
-            Rcpp::checkUserInterrupt();
-          }
-          output[i] = VectorType::get_na();
-        }
+    std::vector<ScalarType> values(size);
+    std::vector<char> isNA(size);
 
-        return output;
-      }
+    s2_parallel_for(size, this->numThreads, [&](int threadId, int64_t begin, int64_t end) {
+      S2CellUnion cellUnion1;
+      S2CellUnion cellUnion2;
 
-      S2CellUnion cellUnion1 = cell_union_from_cell_id_vector(item1);
+      for (int64_t i = begin; i < end; i++) {
+        const CellUnionItem& item1 = items1[size1 == 1 ? 0 : i];
+        const CellUnionItem& item2 = items2[size2 == 1 ? 0 : i];
 
-      for (R_xlen_t i = 0; i < cellUnionVector2.size(); i++) {
-        if ((i % 1000) == 0) {
-          Rcpp::checkUserInterrupt();
+        if (item1.isNull || item2.isNull) {
+          isNA[i] = true;
+          continue;
         }
 
-        item2 = cellUnionVector2[i];
-        if (item2 == R_NilValue) {
-          output[i] = VectorType::get_na();
-        } else {
-          S2CellUnion cellUnion2 = cell_union_from_cell_id_vector(item2);
-          output[i] = this->processCell(cellUnion1, cellUnion2, i);
+        if (size1 != 1) {
+          cellUnion1 = cell_union_from_cell_ids(item1.cellIds, item1.size);
         }
-      }
 
-      return output;
-    } else if (cellUnionVector2.size() == 1) {
-      VectorType output(cellUnionVector1.size());
-
-      item2 = cellUnionVector2[0];
-      if (item2 == R_NilValue) {
-        for (R_xlen_t i = 0; i < cellUnionVector1.size(); i++) {
-          if ((i % 1000) == 0) {
-            Rcpp::checkUserInterrupt();
-          }
-          output[i] = VectorType::get_na();
+        if (size2 != 1) {
+          cellUnion2 = cell_union_from_cell_ids(item2.cellIds, item2.size);
         }
 
-        return output;
+        values[i] = this->processCell(
+          size1 == 1 ? recycled1 : cellUnion1,
+          size2 == 1 ? recycled2 : cellUnion2,
+          i
+        );
       }
+    });
 
-      S2CellUnion cellUnion2 = cell_union_from_cell_id_vector(item2);
-
-      for (R_xlen_t i = 0; i < cellUnionVector1.size(); i++) {
-        if ((i % 1000) == 0) {
-          Rcpp::checkUserInterrupt();
-        }
-
-        item1 = cellUnionVector1[i];
-        if (item1 == R_NilValue) {
-          output[i] = VectorType::get_na();
-        } else {
-          S2CellUnion cellUnion1 = cell_union_from_cell_id_vector(item1);
-          output[i] = this->processCell(cellUnion1, cellUnion2, i);
-        }
+    VectorType output(size);
+    for (R_xlen_t i = 0; i < size; i++) {
+      if ((i % 1000) == 0) {
+        Rcpp::checkUserInterrupt();
       }
 
-      return output;
-    } else {
-      std::stringstream err;
-      err <<
-        "Can't recycle vectors of size " << cellUnionVector1.size() <<
-        " and " << cellUnionVector2.size() <<
-        " to a common length.";
-      stop(err.str());
+      if (isNA[i]) {
+        output[i] = VectorType::get_na();
+      } else {
+        output[i] = cell_union_operator_output(values[i]);
+      }
     }
+
+    return output;
   }
 
   virtual ScalarType processCell(const S2CellUnion& cellUnion1, const S2CellUnion& cellUnion2, R_xlen_t i) = 0;
+
+  int numThreads;
 };
 
 
@@ -206,7 +264,8 @@ LogicalVector cpp_s2_cell_union_is_na(List cellUnionVector) {
 }
 
 // [[Rcpp::export]]
-LogicalVector cpp_s2_cell_union_contains(List cellUnionVector1, List cellUnionVector2) {
+LogicalVector cpp_s2_cell_union_contains(List cellUnionVector1, List cellUnionVector2,
+                                         int numThreads) {
   class Op: public BinaryS2CellUnionOperator<LogicalVector, int> {
     int processCell(const S2CellUnion& cellUnion1, const S2CellUnion& cellUnion2, R_xlen_t i) {
       return cellUnion1.Contains(cellUnion2);
@@ -214,39 +273,66 @@ LogicalVector cpp_s2_cell_union_contains(List cellUnionVector1, List cellUnionVe
   };
 
   Op op;
+  op.numThreads = numThreads;
   return op.processVector(cellUnionVector1, cellUnionVector2);
 }
 
-// optimized because it's a common case
+// optimized because it's a common case: a recycled cell union (e.g., a large
+// mask) is converted only once
 // [[Rcpp::export]]
-LogicalVector cpp_s2_cell_union_contains_cell(List cellUnionVector, NumericVector cellIdVector) {
-  class Op: public UnaryS2CellUnionOperator<LogicalVector, int> {
-    double* cellIdDouble;
-    R_xlen_t cellIdVectorSize;
+LogicalVector cpp_s2_cell_union_contains_cell(List cellUnionVector, NumericVector cellIdVector,
+                                              int numThreads) {
+  R_xlen_t sizeUnion = cellUnionVector.size();
+  R_xlen_t sizeCell = cellIdVector.size();
+  if (sizeUnion != sizeCell && sizeUnion != 1 && sizeCell != 1) {
+    std::stringstream err;
+    err <<
+      "Can't recycle vectors of size " << sizeUnion <<
+      " and " << sizeCell <<
+      " to a common length.";
+    stop(err.str());
+  }
 
-  public:
+  R_xlen_t size = (sizeUnion == 1) ? sizeCell : sizeUnion;
+  std::vector<CellUnionItem> items = cell_union_items(cellUnionVector);
+  const double* cellIdDouble = REAL(cellIdVector);
+  const uint64_t* cellIds = (const uint64_t*) cellIdDouble;
 
-    Op(NumericVector cellIdVector) {
-      cellIdDouble = REAL(cellIdVector);
-      cellIdVectorSize = cellIdVector.size();
-    }
+  S2CellUnion recycled;
+  if (sizeUnion == 1 && !items[0].isNull) {
+    recycled = cell_union_from_cell_ids(items[0].cellIds, items[0].size);
+  }
 
-    int processCell(S2CellUnion& cellUnion, R_xlen_t i) {
-      if (R_IsNA(cellIdDouble[i % cellIdVectorSize])) {
-        return NA_LOGICAL;
-      } else {
-        S2CellId cellId(((uint64_t*) cellIdDouble)[i % cellIdVectorSize]);
-        return cellUnion.Contains(cellId);
+  LogicalVector output(size);
+  int* outputPtr = LOGICAL(output);
+
+  s2_parallel_for(size, numThreads, [&](int threadId, int64_t begin, int64_t end) {
+    S2CellUnion cellUnion;
+
+    for (int64_t i = begin; i < end; i++) {
+      const CellUnionItem& item = items[sizeUnion == 1 ? 0 : i];
+      R_xlen_t iCell = sizeCell == 1 ? 0 : i;
+
+      if (item.isNull || R_IsNA(cellIdDouble[iCell])) {
+        outputPtr[i] = NA_LOGICAL;
+        continue;
+      }
+
+      if (sizeUnion != 1) {
+        cellUnion = cell_union_from_cell_ids(item.cellIds, item.size);
       }
+
+      S2CellId cellId(cellIds[iCell]);
+      outputPtr[i] = (sizeUnion == 1 ? recycled : cellUnion).Contains(cellId);
     }
-  };
+  });
 
-  Op op(cellIdVector);
-  return op.processVector(cellUnionVector);
+  return output;
 }
 
 // [[Rcpp::export]]
-LogicalVector cpp_s2_cell_union_intersects(List cellUnionVector1, List cellUnionVector2) {
+LogicalVector cpp_s2_cell_union_intersects(List cellUnionVector1, List cellUnionVector2,
+                                           int numThreads) {
   class Op: public BinaryS2CellUnionOperator<LogicalVector, int> {
     int processCell(const S2CellUnion& cellUnion1, const S2CellUnion& cellUnion2, R_xlen_t i) {
       return cellUnion1.Intersects(cellUnion2);
@@ -254,51 +340,167 @@ LogicalVector cpp_s2_cell_union_intersects(List cellUnionVector1, List cellUnion
   };
 
   Op op;
+  op.numThreads = numThreads;
   return op.processVector(cellUnionVector1, cellUnionVector2);
 }
 
 // [[Rcpp::export]]
-List cpp_s2_cell_union_intersection(List cellUnionVector1, List cellUnionVector2) {
-  class Op: public BinaryS2CellUnionOperator<List, SEXP> {
-    SEXP processCell(const S2CellUnion& cellUnion1, const S2CellUnion& cellUnion2, R_xlen_t i) {
-      return cell_id_vector_from_cell_union(cellUnion1.Intersection(cellUnion2));
+List cpp_s2_cell_union_intersection(List cellUnionVector1, List cellUnionVector2,
+                                    int numThreads) {
+  class Op: public BinaryS2CellUnionOperator<List, S2CellUnion> {
+    S2CellUnion processCell(const S2CellUnion& cellUnion1, const S2CellUnion& cellUnion2, R_xlen_t i) {
+      return cellUnion1.Intersection(cellUnion2);
     }
   };
 
   Op op;
+  op.numThreads = numThreads;
   List out = op.processVector(cellUnionVector1, cellUnionVector2);
   out.attr("class") = CharacterVector::create("s2_cell_union", "wk_vctr");
   return out;
 }
 
 // [[Rcpp::export]]
-List cpp_s2_cell_union_union(List cellUnionVector1, List cellUnionVector2) {
-  class Op: public BinaryS2CellUnionOperator<List, SEXP> {
-    SEXP processCell(const S2CellUnion& cellUnion1, const S2CellUnion& cellUnion2, R_xlen_t i) {
-      return cell_id_vector_from_cell_union(cellUnion1.Union(cellUnion2));
+List cpp_s2_cell_union_union(List cellUnionVector1, List cellUnionVector2,
+                             int numThreads) {
+  class Op: public BinaryS2CellUnionOperator<List, S2CellUnion> {
+    S2CellUnion processCell(const S2CellUnion& cellUnion1, const S2CellUnion& cellUnion2, R_xlen_t i) {
+      return cellUnion1.Union(cellUnion2);
     }
   };
 
   Op op;
+  op.numThreads = numThreads;
   List out = op.processVector(cellUnionVector1, cellUnionVector2);
   out.attr("class") = CharacterVector::create("s2_cell_union", "wk_vctr");
   return out;
 }
 
 // [[Rcpp::export]]
-List cpp_s2_cell_union_difference(List cellUnionVector1, List cellUnionVector2) {
-  class Op: public BinaryS2CellUnionOperator<List, SEXP> {
-    SEXP processCell(const S2CellUnion& cellUnion1, const S2CellUnion& cellUnion2, R_xlen_t i) {
-      return cell_id_vector_from_cell_union(cellUnion1.Difference(cellUnion2));
+List cpp_s2_cell_union_difference(List cellUnionVector1, List cellUnionVector2,
+                                  int numThreads) {
+  class Op: public BinaryS2CellUnionOperator<List, S2CellUnion> {
+    S2CellUnion processCell(const S2CellUnion& cellUnion1, const S2CellUnion& cellUnion2, R_xlen_t i) {
+      return cellUnion1.Difference(cellUnion2);
     }
   };
 
   Op op;
+  op.numThreads = numThreads;
   List out = op.processVector(cellUnionVector1, cellUnionVector2);
   out.attr("class") = CharacterVector::create("s2_cell_union", "wk_vctr");
   return out;
 }
 
+// Compact encoding (see s2coding::EncodedS2CellIdVector) of each element,
+// which can be queried without decoding
+
+// [[Rcpp::export]]
+List cpp_s2_cell_union_encode(List cellUnionVector) {
+  List out(cellUnionVector.size());
+  Encoder encoder;
+  std::vector<S2CellId> cells;
+
+  for (R_xlen_t i = 0; i < cellUnionVector.size(); i++) {
+    if ((i % 1000) == 0) {
+      Rcpp::checkUserInterrupt();
+    }
+
+    SEXP item = cellUnionVector[i];
+    if (item == R_NilValue) {
+      out[i] = R_NilValue;
+      continue;
+    }
+
+    // encode the cells as they are stored (i.e., without normalizing)
+    const uint64_t* ptrCellId = (const uint64_t*) REAL(item);
+    cells.clear();
+    for (R_xlen_t j = 0; j < Rf_xlength(item); j++) {
+      cells.emplace_back(ptrCellId[j]);
+    }
+
+    encoder.clear();
+    s2coding::EncodeS2CellIdVector(cells, &encoder);
+
+    RawVector encoded(encoder.length());
+    memcpy(RAW(encoded), encoder.base(), encoder.length());
+    out[i] = encoded;
+  }
+
+  return out;
+}
+
+// [[Rcpp::export]]
+List cpp_s2_cell_union_decode(List encodedVector) {
+  List out(encodedVector.size());
+  Decoder decoder;
+  s2coding::EncodedS2CellIdVector cells;
+
+  for (R_xlen_t i = 0; i < encodedVector.size(); i++) {
+    if ((i % 1000) == 0) {
+      Rcpp::checkUserInterrupt();
+    }
+
+    SEXP item = encodedVector[i];
+    if (item == R_NilValue) {
+      out[i] = R_NilValue;
+      continue;
+    }
+
+    decoder = Decoder(RAW(item), Rf_xlength(item));
+    if (!cells.Init(&decoder)) {
+      stop("Can't decode encoded s2_cell_union at index %d", i + 1);
+    }
+
+    NumericVector cellIdNumeric(cells.size());
+    for (size_t j = 0; j < cells.size(); j++) {
+      cellIdNumeric[j] = reinterpret_double(cells[j].id());
+    }
+
+    cellIdNumeric.attr("class") = CharacterVector::create("s2_cell", "wk_vctr");
+    out[i] = cellIdNumeric;
+  }
+
+  out.attr("class") = CharacterVector::create("s2_cell_union", "wk_vctr");
+  return out;
+}
+
+// Same as S2CellUnion::Contains(S2CellId) but uses the encoded vector directly
+// [[Rcpp::export]]
+LogicalVector cpp_s2_cell_union_encoded_contains_cell(List encodedVector,
+                                                      NumericVector cellIdVector) {
+  LogicalVector out(encodedVector.size());
+  Decoder decoder;
+  s2coding::EncodedS2CellIdVector cells;
+
+  for (R_xlen_t i = 0; i < encodedVector.size(); i++) {
+    if ((i % 1000) == 0) {
+      Rcpp::checkUserInterrupt();
+    }
+
+    SEXP item = encodedVector[i];
+    if (item == R_NilValue || R_IsNA(cellIdVector[i])) {
+      out[i] = NA_LOGICAL;
+      continue;
+    }
+
+    decoder = Decoder(RAW(item), Rf_xlength(item));
+    if (!cells.Init(&decoder)) {
+      stop("Can't decode encoded s2_cell_union at index %d", i + 1);
+    }
+
+    uint64_t cellIdValue;
+    memcpy(&cellIdValue, &(cellIdVector[i]), sizeof(uint64_t));
+    S2CellId cellId(cellIdValue);
+
+    size_t j = cells.lower_bound(cellId);
+    out[i] = (j < cells.size() && cells[j].range_min() <= cellId) ||
+      (j != 0 && cells[j - 1].range_max() >= cellId);
+  }
+
+  return out;
+}
+
 // [[Rcpp::export]]
 List cpp_s2_geography_from_cell_union(List cellUnionVector) {
   class Op: public UnaryS2CellUnionOperator<List, SEXP> {
@@ -353,6 +555,172 @@ List cpp_s2_covering_cell_ids(List geog, int min_level, int max_level,
 }
 
 
+// Coverings of many features are returned as a flat (feature, cell) table.
+// Each thread uses its own S2RegionCoverer and collects the cells for its
+// (contiguous) chunk of features, so concatenating the chunks in thread order
+// keeps the output sorted by feature.
+struct CoveringTableChunk {
+  std::vector<int> feature;
+  std::vector<uint64_t> cellId;
+
+  void push_back(int64_t i, S2CellId cellId) {
+    this->feature.push_back(i + 1);
+    this->cellId.push_back(cellId.id());
+  }
+};
+
+static void covering_table_check_levels(int minLevel, int maxLevel) {
+  if (minLevel < 0 || maxLevel > S2CellId::kMaxLevel || minLevel > maxLevel) {
+    stop("`min_level` and `max_level` must be between 0 and 30 with min_level <= max_level");
+  }
+}
+
+static List covering_table_output(std::vector<CoveringTableChunk>& chunks) {
+  size_t size = 0;
+  for (const CoveringTableChunk& chunk : chunks) {
+    size += chunk.feature.size();
+  }
+
+  IntegerVector featureOut(size);
+  NumericVector cellOut(size);
+  R_xlen_t j = 0;
+  for (CoveringTableChunk& chunk : chunks) {
+    for (size_t i = 0; i < chunk.feature.size(); i++, j++) {
+      featureOut[j] = chunk.feature[i];
+      cellOut[j] = reinterpret_double(chunk.cellId[i]);
+    }
+
+    chunk = CoveringTableChunk();
+  }
+
+  cellOut.attr("class") = CharacterVector::create("s2_cell", "wk_vctr");
+  return List::create(_["feature"] = featureOut, _["cell"] = cellOut);
+}
+
+// Without a buffer, a single point is assigned to the one cell at max_level
+// that contains it, which doesn't need a shape index or a region coverer. This
+// differs from the covering for a point on a cell boundary, which includes
+// every adjacent cell (the point's cell is always one of them).
+static inline const S2Point* covering_single_point(const s2geography::Geography& geog,
+                                                   double buffer, bool interior) {
+  if (interior || buffer != 0) {
+    return nullptr;
+  }
+
+  auto points = s2geography::geography_cast<s2geography::PointGeography>(&geog);
+  if (points == nullptr || points->Points().size() != 1) {
+    return nullptr;
+  }
+
+  return &points->Points()[0];
+}
+
+// [[Rcpp::export]]
+List cpp_s2_covering_cell_ids_table(List geog, int min_level, int max_level,
+                                    int max_cells, NumericVector buffer, bool interior,
+                                    int numThreads) {
+  covering_table_check_levels(min_level, max_level);
+
+  R_xlen_t size = geog.size();
+  const double* bufferPtr = REAL(buffer);
+
+  // RGeography::Index() is built lazily and must be built here (and only for
+  // features that need it) before any worker can use it
+  std::vector<const s2geography::Geography*> features(size, nullptr);
+  std::vector<const s2geography::ShapeIndexGeography*> indexes(size, nullptr);
+  for (R_xlen_t i = 0; i < size; i++) {
+    SEXP item = geog[i];
+    if (item == R_NilValue || ISNAN(bufferPtr[i])) {
+      continue;
+    }
+
+    RGeography* feature = reinterpret_cast<RGeography*>(R_ExternalPtrAddr(item));
+    features[i] = &feature->Geog();
+    if (covering_single_point(*features[i], bufferPtr[i], interior) == nullptr) {
+      indexes[i] = &feature->Index();
+    }
+  }
+
+  S2RegionCoverer::Options options;
+  options.set_min_level(min_level);
+  options.set_max_level(max_level);
+  options.set_max_cells(max_cells);
+
+  numThreads = s2_parallel_num_threads(numThreads, size);
+  std::vector<CoveringTableChunk> chunks(numThreads);
+
+  s2_parallel_for(size, numThreads, [&](int threadId, int64_t begin, int64_t end) {
+    S2RegionCoverer coverer(options);
+    CoveringTableChunk& chunk = chunks[threadId];
+    std::vector<S2CellId> covering;
+
+    for (int64_t i = begin; i < end; i++) {
+      if (features[i] == nullptr) {
+        continue;
+      }
+
+      const S2Point* point = covering_single_point(*features[i], bufferPtr[i], interior);
+      if (point != nullptr) {
+        chunk.push_back(i, S2CellId(*point).parent(max_level));
+        continue;
+      }
+
+      S2ShapeIndexBufferedRegion region(
+        &indexes[i]->ShapeIndex(),
+        S1ChordAngle::Radians(bufferPtr[i])
+      );
+
+      if (interior) {
+        coverer.GetInteriorCovering(region, &covering);
+      } else {
+        coverer.GetCovering(region, &covering);
+      }
+
+      for (const S2CellId& cellId : covering) {
+        chunk.push_back(i, cellId);
+      }
+    }
+  });
+
+  return covering_table_output(chunks);
+}
+
+// Point vectors (without a buffer) are assigned to the cell at max_level that
+// contains each point, as in covering_single_point()
+// [[Rcpp::export]]
+List cpp_s2_covering_cell_ids_table_point_vector(List x, int min_level, int max_level,
+                                                 int numThreads) {
+  covering_table_check_levels(min_level, max_level);
+
+  NumericVector xs = x[0];
+  NumericVector ys = x[1];
+  NumericVector zs = x[2];
+  const double* ptrX = REAL(xs);
+  const double* ptrY = REAL(ys);
+  const double* ptrZ = REAL(zs);
+  R_xlen_t size = xs.size();
+
+  numThreads = s2_parallel_num_threads(numThreads, size);
+  std::vector<CoveringTableChunk> chunks(numThreads);
+
+  s2_parallel_for(size, numThreads, [&](int threadId, int64_t begin, int64_t end) {
+    CoveringTableChunk& chunk = chunks[threadId];
+    chunk.feature.reserve(end - begin);
+    chunk.cellId.reserve(end - begin);
+
+    for (int64_t i = begin; i < end; i++) {
+      if (ISNAN(ptrX[i]) || ISNAN(ptrY[i]) || ISNAN(ptrZ[i])) {
+        continue;
+      }
+
+      S2CellId cellId(S2Point(ptrX[i], ptrY[i], ptrZ[i]));
+      chunk.push_back(i, cellId.parent(max_level));
+    }
+  });
+
+  return covering_table_output(chunks);
+}
+
 // [[Rcpp::export]]
 List cpp_s2_covering_cell_ids_agg(List geog, int min_level, int max_level,
                                   int max_cells, double buffer, bool interior, bool naRm) {
@@ -1,5 +1,6 @@
 
 #include <cstdint>
+#include <limits>
 #include <vector>
 #include <sstream>
 #include <algorithm>
@@ -8,8 +9,10 @@
 #include "s2/s2cell_id.h"
 #include "s2/s2cell.h"
 #include "s2/s2latlng.h"
+#include "s2/encoded_s2cell_id_vector.h"
 
 #include "geography.h"
+#include "s2-parallel.h"
 
 #include <Rcpp.h>
 using namespace Rcpp;
@@ -533,6 +536,157 @@ NumericVector cpp_s2_cell_edge_neighbour(NumericVector cellIdVector, IntegerVect
   return result;
 }
 
+// Reusable buffers for expanding the neighbourhood of one cell at a time
+class CellNeighbourhoodExpander {
+public:
+  CellNeighbourhoodExpander(bool edgeOnly): edgeOnly(edgeOnly) {}
+
+  // Replaces the contents of result with the sorted, unique cells at the same
+  // level as cellId that are within k steps of cellId (including cellId)
+  void Expand(S2CellId cellId, int k, std::vector<uint64_t>* result) {
+    result->clear();
+    result->push_back(cellId.id());
+    frontier.clear();
+    frontier.push_back(cellId);
+
+    int level = cellId.level();
+    for (int step = 0; step < k; step++) {
+      neighbours.clear();
+      for (const S2CellId& cell : frontier) {
+        if (edgeOnly) {
+          S2CellId edgeNeighbours[4];
+          cell.GetEdgeNeighbors(edgeNeighbours);
+          neighbours.insert(neighbours.end(), edgeNeighbours, edgeNeighbours + 4);
+        } else {
+          cell.AppendAllNeighbors(level, &neighbours);
+        }
+      }
+
+      std::sort(neighbours.begin(), neighbours.end());
+      neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+
+      // the next frontier is everything we haven't already seen
+      frontier.clear();
+      for (const S2CellId& cell : neighbours) {
+        if (!std::binary_search(result->begin(), result->end(), cell.id())) {
+          frontier.push_back(cell);
+        }
+      }
+
+      if (frontier.empty()) {
+        break;
+      }
+
+      size_t previousSize = result->size();
+      for (const S2CellId& cell : frontier) {
+        result->push_back(cell.id());
+      }
+
+      std::inplace_merge(result->begin(), result->begin() + previousSize, result->end());
+    }
+  }
+
+private:
+  bool edgeOnly;
+  std::vector<S2CellId> frontier;
+  std::vector<S2CellId> neighbours;
+};
+
+static void cell_sort_unique(std::vector<uint64_t>& cells) {
+  std::sort(cells.begin(), cells.end());
+  cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+}
+
+static NumericVector cell_vector_from_ids(const std::vector<uint64_t>& cells) {
+  NumericVector out(cells.size());
+  for (size_t i = 0; i < cells.size(); i++) {
+    out[i] = reinterpret_double(cells[i]);
+  }
+
+  out.attr("class") = CharacterVector::create("s2_cell", "wk_vctr");
+  return out;
+}
+
+// [[Rcpp::export]]
+SEXP cpp_s2_cell_neighbourhood(NumericVector cellIdVector, IntegerVector k,
+                               bool edgeOnly, bool flatten, int numThreads) {
+  R_xlen_t size = cellIdVector.size();
+  if (k.size() != size) {
+    stop("`k` must be the same length as `x`");
+  }
+
+  const double* ptrDouble = REAL(cellIdVector);
+  const uint64_t* ptrCellId = (const uint64_t*) ptrDouble;
+  const int* ptrK = INTEGER(k);
+
+  numThreads = s2_parallel_num_threads(numThreads, size);
+  std::vector<CellNeighbourhoodExpander> expanders(numThreads, CellNeighbourhoodExpander(edgeOnly));
+
+  auto cellIsValid = [&](R_xlen_t i) {
+    return !R_IsNA(ptrDouble[i]) &&
+      ptrK[i] != NA_INTEGER &&
+      ptrK[i] >= 0 &&
+      S2CellId(ptrCellId[i]).is_valid();
+  };
+
+  if (flatten) {
+    // collect the unique cells from each chunk, then merge the (sorted)
+    // chunk results
+    std::vector<std::vector<uint64_t>> partial(numThreads);
+    s2_parallel_for(size, numThreads, [&](int threadId, int64_t begin, int64_t end) {
+      std::vector<uint64_t> cells;
+      for (int64_t i = begin; i < end; i++) {
+        if (!cellIsValid(i)) {
+          continue;
+        }
+
+        expanders[threadId].Expand(S2CellId(ptrCellId[i]), ptrK[i], &cells);
+        partial[threadId].insert(partial[threadId].end(), cells.begin(), cells.end());
+      }
+
+      cell_sort_unique(partial[threadId]);
+    });
+
+    std::vector<uint64_t> cells = std::move(partial[0]);
+    for (int threadId = 1; threadId < numThreads; threadId++) {
+      size_t previousSize = cells.size();
+      cells.insert(cells.end(), partial[threadId].begin(), partial[threadId].end());
+      std::inplace_merge(cells.begin(), cells.begin() + previousSize, cells.end());
+      partial[threadId].clear();
+    }
+
+    cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+    return cell_vector_from_ids(cells);
+  }
+
+  std::vector<std::vector<uint64_t>> neighbourhoods(size);
+  s2_parallel_for(size, numThreads, [&](int threadId, int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      if (cellIsValid(i)) {
+        expanders[threadId].Expand(S2CellId(ptrCellId[i]), ptrK[i], &(neighbourhoods[i]));
+      }
+    }
+  });
+
+  List result(size);
+  for (R_xlen_t i = 0; i < size; i++) {
+    if ((i % 1000) == 0) {
+      Rcpp::checkUserInterrupt();
+    }
+
+    if (cellIsValid(i)) {
+      result[i] = cell_vector_from_ids(neighbourhoods[i]);
+      std::vector<uint64_t>().swap(neighbourhoods[i]);
+    } else {
+      NumericVector na = NumericVector::create(NA_REAL);
+      na.attr("class") = CharacterVector::create("s2_cell", "wk_vctr");
+      result[i] = na;
+    }
+  }
+
+  return result;
+}
+
 // Ops for Ops, Math, Summary generics
 
 // [[Rcpp::export]]
@@ -810,3 +964,259 @@ int cpp_s2_cell_common_ancestor_level_agg(NumericVector cellId) {
 
   return cellIdCommon.level();
 }
+
+// Histogram (count/sum by cell) aggregation
+
+struct CellHistogramBin {
+  uint64_t cell;
+  double count;
+  double sum;
+
+  bool operator<(const CellHistogramBin& other) const {
+    return cell < other.cell;
+  }
+};
+
+// Collapses runs of identical (sorted) cells in place
+static void cell_histogram_collapse(std::vector<CellHistogramBin>& bins) {
+  if (bins.empty()) {
+    return;
+  }
+
+  size_t out = 0;
+  for (size_t i = 1; i < bins.size(); i++) {
+    if (bins[i].cell == bins[out].cell) {
+      bins[out].count += bins[i].count;
+      bins[out].sum += bins[i].sum;
+    } else {
+      bins[++out] = bins[i];
+    }
+  }
+
+  bins.resize(out + 1);
+}
+
+// Each thread sorts and collapses the (parent cell, weight) pairs for its
+// chunk of the input; the (much smaller) sorted runs are then merged and
+// collapsed again. Because S2CellId ordering is preserved when taking
+// the parent of every cell at a fixed level, coarser levels of the pyramid
+// are derived from the finest table without any further sorting.
+template <typename CellIdFun>
+List cell_histogram(R_xlen_t size, CellIdFun cell_id_fun, NumericVector weight,
+                    IntegerVector level, int numThreads) {
+  if (weight.size() != 0 && weight.size() != size) {
+    stop("`weight` must be length 0 or the same length as `x`");
+  }
+
+  int maxLevel = -1;
+  for (R_xlen_t j = 0; j < level.size(); j++) {
+    if (level[j] == NA_INTEGER || level[j] < 0 || level[j] > S2CellId::kMaxLevel) {
+      stop("`level` must be between 0 and 30");
+    }
+
+    maxLevel = std::max<int>(maxLevel, level[j]);
+  }
+
+  const double* weightPtr = weight.size() == 0 ? nullptr : REAL(weight);
+  numThreads = s2_parallel_num_threads(numThreads, size);
+  std::vector<std::vector<CellHistogramBin>> partial(numThreads);
+
+  s2_parallel_for(size, numThreads, [&](int threadId, int64_t begin, int64_t end) {
+    std::vector<CellHistogramBin>& bins = partial[threadId];
+    bins.reserve(end - begin);
+
+    for (int64_t i = begin; i < end; i++) {
+      S2CellId cellId = cell_id_fun(i);
+      if (!cellId.is_valid() || cellId.level() < maxLevel) {
+        continue;
+      }
+
+      double weighti = weightPtr == nullptr ? 1 : weightPtr[i];
+      bins.push_back({cellId.parent(maxLevel).id(), 1, weighti});
+    }
+
+    std::sort(bins.begin(), bins.end());
+    cell_histogram_collapse(bins);
+  });
+
+  std::vector<CellHistogramBin> bins = std::move(partial[0]);
+  for (int threadId = 1; threadId < numThreads; threadId++) {
+    size_t previousSize = bins.size();
+    bins.insert(bins.end(), partial[threadId].begin(), partial[threadId].end());
+    std::inplace_merge(bins.begin(), bins.begin() + previousSize, bins.end());
+    partial[threadId].clear();
+  }
+
+  cell_histogram_collapse(bins);
+
+  // build the output for each requested level, reusing the finest table
+  std::vector<CellHistogramBin> levelBins;
+  std::vector<CellHistogramBin> allBins;
+  for (R_xlen_t j = 0; j < level.size(); j++) {
+    levelBins = bins;
+    if (level[j] != maxLevel) {
+      for (CellHistogramBin& bin : levelBins) {
+        bin.cell = S2CellId(bin.cell).parent(level[j]).id();
+      }
+
+      cell_histogram_collapse(levelBins);
+    }
+
+    allBins.insert(allBins.end(), levelBins.begin(), levelBins.end());
+  }
+
+  R_xlen_t outSize = allBins.size();
+  NumericVector cellOut(outSize);
+  NumericVector countOut(outSize);
+  NumericVector sumOut(outSize);
+  for (R_xlen_t i = 0; i < outSize; i++) {
+    cellOut[i] = reinterpret_double(allBins[i].cell);
+    countOut[i] = allBins[i].count;
+    sumOut[i] = allBins[i].sum;
+  }
+
+  cellOut.attr("class") = CharacterVector::create("s2_cell", "wk_vctr");
+  return List::create(_["cell"] = cellOut, _["count"] = countOut, _["sum"] = sumOut);
+}
+
+// [[Rcpp::export]]
+List cpp_s2_cell_histogram(NumericVector cellIdVector, NumericVector weight,
+                           IntegerVector level, int numThreads) {
+  const double* ptrDouble = REAL(cellIdVector);
+  const uint64_t* ptrCellId = (const uint64_t*) ptrDouble;
+
+  return cell_histogram(
+    cellIdVector.size(),
+    [&](R_xlen_t i) {
+      if (R_IsNA(ptrDouble[i])) {
+        return S2CellId::None();
+      } else {
+        return S2CellId(ptrCellId[i]);
+      }
+    },
+    weight,
+    level,
+    numThreads
+  );
+}
+
+// [[Rcpp::export]]
+List cpp_s2_cell_histogram_lnglat(List lnglat, NumericVector weight,
+                                  IntegerVector level, int numThreads) {
+  NumericVector lng = lnglat[0];
+  NumericVector lat = lnglat[1];
+  const double* ptrLng = REAL(lng);
+  const double* ptrLat = REAL(lat);
+
+  return cell_histogram(
+    lng.size(),
+    [&](R_xlen_t i) {
+      if (ISNAN(ptrLng[i]) || ISNAN(ptrLat[i])) {
+        return S2CellId::None();
+      } else {
+        S2LatLng ll = S2LatLng::FromDegrees(ptrLat[i], ptrLng[i]).Normalized();
+        return S2CellId(ll);
+      }
+    },
+    weight,
+    level,
+    numThreads
+  );
+}
+
+// Compact encoding (see s2coding::EncodedS2CellIdVector), which can be
+// queried without decoding the entire vector
+
+static void cell_encoded_init(const RawVector& encoded, Decoder* decoder,
+                              s2coding::EncodedS2CellIdVector* cells) {
+  *decoder = Decoder(RAW(encoded), encoded.size());
+  if (!cells->Init(decoder)) {
+    stop("Can't decode encoded s2_cell vector");
+  }
+}
+
+// [[Rcpp::export]]
+RawVector cpp_s2_cell_encode(NumericVector cellIdVector) {
+  const uint64_t* ptrCellId = (const uint64_t*) REAL(cellIdVector);
+  std::vector<S2CellId> cells(ptrCellId, ptrCellId + cellIdVector.size());
+
+  Encoder encoder;
+  s2coding::EncodeS2CellIdVector(cells, &encoder);
+
+  RawVector out(encoder.length());
+  memcpy(RAW(out), encoder.base(), encoder.length());
+  return out;
+}
+
+// [[Rcpp::export]]
+NumericVector cpp_s2_cell_decode(RawVector encoded, SEXP indices) {
+  Decoder decoder;
+  s2coding::EncodedS2CellIdVector cells;
+  cell_encoded_init(encoded, &decoder, &cells);
+
+  NumericVector out;
+  if (indices == R_NilValue) {
+    // decode everything
+    out = NumericVector(cells.size());
+    for (size_t j = 0; j < cells.size(); j++) {
+      out[j] = reinterpret_double(cells[j].id());
+    }
+  } else {
+    // decode only the requested (1-based) elements
+    IntegerVector i(indices);
+    out = NumericVector(i.size());
+    R_xlen_t size = cells.size();
+    for (R_xlen_t j = 0; j < i.size(); j++) {
+      if (i[j] == NA_INTEGER || i[j] < 1 || i[j] > size) {
+        out[j] = NA_REAL;
+      } else {
+        out[j] = reinterpret_double(cells[i[j] - 1].id());
+      }
+    }
+  }
+
+  out.attr("class") = CharacterVector::create("s2_cell", "wk_vctr");
+  return out;
+}
+
+// Like length(), returns a double if the number of cells is too large to
+// be represented as an integer
+// [[Rcpp::export]]
+SEXP cpp_s2_cell_encoded_size(RawVector encoded) {
+  Decoder decoder;
+  s2coding::EncodedS2CellIdVector cells;
+  cell_encoded_init(encoded, &decoder, &cells);
+  if (cells.size() > static_cast<size_t>(std::numeric_limits<int>::max())) {
+    return NumericVector::create(static_cast<double>(cells.size()));
+  } else {
+    return IntegerVector::create(static_cast<int>(cells.size()));
+  }
+}
+
+// [[Rcpp::export]]
+IntegerVector cpp_s2_cell_encoded_lower_bound(RawVector encoded, NumericVector cellIdVector) {
+  Decoder decoder;
+  s2coding::EncodedS2CellIdVector cells;
+  cell_encoded_init(encoded, &decoder, &cells);
+  if (cells.size() >= static_cast<size_t>(std::numeric_limits<int>::max())) {
+    stop("Can't compute integer positions in an encoded vector with %s cells",
+         std::to_string(cells.size()));
+  }
+
+  IntegerVector out(cellIdVector.size());
+  for (R_xlen_t i = 0; i < cellIdVector.size(); i++) {
+    if ((i % 1000) == 0) {
+      Rcpp::checkUserInterrupt();
+    }
+
+    if (R_IsNA(cellIdVector[i])) {
+      out[i] = NA_INTEGER;
+    } else {
+      uint64_t cellId;
+      memcpy(&cellId, &(cellIdVector[i]), sizeof(uint64_t));
+      out[i] = cells.lower_bound(S2CellId(cellId)) + 1;
+    }
+  }
+
+  return out;
+}
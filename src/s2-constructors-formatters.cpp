@@ -3,10 +3,13 @@
 #include <R.h>
 #include <Rinternals.h>
 
+#include "s2/s2cell.h"
 #include "s2/s2pointutil.h"
+#include "s2/util/coding/coder.h"
 
 #include "wk-v1.h"
 #include "geography.h"
+#include "s2-parallel.h"
 
 
 #define CPP_START                         \
@@ -45,76 +48,148 @@
     return WK_ABORT;
 
 
+// Features read by the geography writer are accumulated in a C++ buffer
+// rather than in an R list so that the list is allocated exactly once when
+// all features have been read. A buffer can also outlive the handler that
+// filled it so that several inputs can be appended to it (see
+// c_s2_geography_buffer_finish()).
+using GeographyBuffer = std::vector<std::unique_ptr<s2geography::Geography>>;
+
 typedef struct {
     s2geography::util::FeatureConstructor* builder;
-    SEXP result;
-    R_xlen_t feat_id;
+    GeographyBuffer* features;
+    // features before this index were read by a previous (completed) vector
+    size_t committed_size;
+    int append;
+    int arena;
     int coord_size;
+    int check;
+    int num_threads;
     char cpp_exception_error[8096];
 } builder_handler_t;
 
 
-// TODO: Both of these allocate in a way that could longjmp and possibly leak memory
-static inline void builder_result_append(builder_handler_t* data, SEXP value) {
-    R_xlen_t current_size = Rf_xlength(data->result);
-    if (data->feat_id >= current_size) {
-        SEXP new_result = PROTECT(Rf_allocVector(VECSXP, current_size * 2 + 1));
-        for (R_xlen_t i = 0; i < current_size; i++) {
-            SET_VECTOR_ELT(new_result, i, VECTOR_ELT(data->result, i));
-        }
-        R_ReleaseObject(data->result);
-        data->result = new_result;
-        R_PreserveObject(data->result);
-        UNPROTECT(1);
+// Errors that occur while building or checking features on a worker thread
+// are reported with the (1-based) index of the offending feature
+[[noreturn]] static void throw_feature_error(int64_t i, const std::exception& e) {
+    std::stringstream err;
+    err << "Feature " << (i + 1) << ": " << e.what();
+    throw s2geography::Exception(err.str());
+}
+
+// Wraps features created by the writer or the readers below in an
+// s2_geography vector (nullptr features become NULL). With arena = TRUE,
+// features are allocated from a single RGeographyBlock.
+template <typename T>
+static SEXP geography_vector(std::vector<std::unique_ptr<T>>& features, SEXP arena_sexp) {
+  R_xlen_t n = features.size();
+  SEXP result = PROTECT(Rf_allocVector(VECSXP, n));
+
+  SEXP block_xptr = R_NilValue;
+  if (LOGICAL(arena_sexp)[0]) {
+    block_xptr = RGeographyBlock::MakeXPtr(n);
+  }
+  PROTECT(block_xptr);
+
+  for (R_xlen_t i = 0; i < n; i++) {
+    if (!features[i]) {
+      continue;
+    }
+
+    SEXP feature_xptr;
+    if (block_xptr != R_NilValue) {
+      feature_xptr = PROTECT(RGeographyBlock::MakeFeatureXPtr(block_xptr, std::move(features[i])));
+    } else {
+      feature_xptr = PROTECT(RGeography::MakeXPtr(std::move(features[i])));
     }
 
-    SET_VECTOR_ELT(data->result, data->feat_id, value);
-    data->feat_id++;
+    SET_VECTOR_ELT(result, i, feature_xptr);
+    UNPROTECT(1);
+  }
+  UNPROTECT(1);
+
+  SEXP cls = PROTECT(Rf_allocVector(STRSXP, 2));
+  SET_STRING_ELT(cls, 0, Rf_mkChar("s2_geography"));
+  SET_STRING_ELT(cls, 1, Rf_mkChar("wk_vctr"));
+  Rf_setAttrib(result, R_ClassSymbol, cls);
+  UNPROTECT(2);
+  return result;
 }
 
-static inline void builder_result_finalize(builder_handler_t* data) {
-    R_xlen_t current_size = Rf_xlength(data->result);
-    if (data->feat_id != current_size) {
-        SEXP new_result = PROTECT(Rf_allocVector(VECSXP, data->feat_id));
-        for (R_xlen_t i = 0; i < data->feat_id; i++) {
-            SET_VECTOR_ELT(new_result, i, VECTOR_ELT(data->result, i));
+// With check = TRUE, the builder constructs features without checking them
+// and the (expensive) validation of the features read by this vector is done
+// after all of them have been read, using data->num_threads threads. When
+// appending, features are numbered within the input being appended.
+static void builder_check_result(builder_handler_t* data) {
+    const GeographyBuffer& features = *data->features;
+    int64_t offset = data->committed_size;
+    int64_t n = features.size() - offset;
+
+    s2_parallel_for(n, data->num_threads, [&](int thread_id, int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+            const s2geography::Geography* feature = features[offset + i].get();
+            if (feature == nullptr) {
+                continue;
+            }
+
+            try {
+                s2geography::util::CheckFeature(*feature);
+            } catch (std::exception& e) {
+                throw_feature_error(i, e);
+            }
         }
-        R_ReleaseObject(data->result);
-        data->result = new_result;
-        R_PreserveObject(data->result);
-        UNPROTECT(1);
-    }
+    });
 }
 
 int builder_vector_start(const wk_vector_meta_t* meta, void* handler_data) {
   builder_handler_t* data = (builder_handler_t*) handler_data;
-
-  if (data->result != R_NilValue) {
-      Rf_error("Destination vector was already allocated"); // # nocov
-  }
-
-  if (meta->size == WK_VECTOR_SIZE_UNKNOWN) {
-      data->result = PROTECT(Rf_allocVector(VECSXP, 1024));
-  } else {
-      data->result = PROTECT(Rf_allocVector(VECSXP, meta->size));
+  WK_METHOD_CPP_START
+  data->committed_size = data->features->size();
+
+  // grow geometrically so that appending many chunks doesn't reallocate
+  // (and move) the whole buffer for each one
+  if (meta->size != WK_VECTOR_SIZE_UNKNOWN) {
+    size_t needed = data->committed_size + meta->size;
+    size_t capacity = data->features->capacity();
+    if (needed > capacity) {
+      data->features->reserve(std::max(needed, 2 * capacity));
+    }
   }
-  R_PreserveObject(data->result);
-  UNPROTECT(1);
-
-  data->feat_id = 0;
 
   return WK_CONTINUE;
+  WK_METHOD_CPP_END_INT
 }
 
 SEXP builder_vector_end(const wk_vector_meta_t* meta, void* handler_data) {
   builder_handler_t* data = (builder_handler_t*) handler_data;
-  builder_result_finalize(data);
-  SEXP cls = PROTECT(Rf_allocVector(STRSXP, 2));
-  SET_STRING_ELT(cls, 0, Rf_mkChar("s2_geography"));
-  SET_STRING_ELT(cls, 1, Rf_mkChar("wk_vctr"));
-  Rf_setAttrib(data->result, R_ClassSymbol, cls);
-  UNPROTECT(1);
-  return data->result;
+
+  if (data->check) {
+    bool check_failed = false;
+    try {
+      builder_check_result(data);
+    } catch (std::exception& e) {
+      strncpy(data->cpp_exception_error, e.what(), 8096 - 1);
+      check_failed = true;
+    }
+
+    if (check_failed) {
+      Rf_error("%s", data->cpp_exception_error);
+    }
+  }
+
+  // appended features are kept for the next vector (or until the buffer
+  // is finished)
+  data->committed_size = data->features->size();
+  if (data->append) {
+    return R_NilValue;
+  }
+
+  SEXP arena_sexp = PROTECT(Rf_ScalarLogical(data->arena));
+  SEXP result = PROTECT(geography_vector(*data->features, arena_sexp));
+  data->features->clear();
+  data->committed_size = 0;
+  UNPROTECT(2);
+  return result;
 }
 
 int builder_feature_start(const wk_vector_meta_t* meta, R_xlen_t feat_id, void* handler_data) {
@@ -127,17 +202,16 @@ int builder_feature_start(const wk_vector_meta_t* meta, R_xlen_t feat_id, void*
 
 int builder_feature_null(void* handler_data) {
   builder_handler_t* data = (builder_handler_t*) handler_data;
-  builder_result_append(data, R_NilValue);
+  WK_METHOD_CPP_START
+  data->features->push_back(nullptr);
   return WK_ABORT_FEATURE;
+  WK_METHOD_CPP_END_INT
 }
 
 int builder_feature_end(const wk_vector_meta_t* meta, R_xlen_t feat_id, void* handler_data) {
   builder_handler_t* data = (builder_handler_t*) handler_data;
   WK_METHOD_CPP_START
-  std::unique_ptr<s2geography::Geography> feat = data->builder->finish_feature();
-  SEXP feature_xptr = PROTECT(RGeography::MakeXPtr(std::move(feat)));
-  builder_result_append(data, feature_xptr);
-  UNPROTECT(1);
+  data->features->push_back(data->builder->finish_feature());
   return WK_CONTINUE;
   WK_METHOD_CPP_END_INT
 }
@@ -213,11 +287,12 @@ int builder_error(const char* message, void* handler_data) {
   return WK_ABORT;
 }
 
+// Drops features from a vector that was not read completely (e.g., because
+// of an error) so that they are not included in an appended result
 void builder_deinitialize(void* handler_data) {
   builder_handler_t* data = (builder_handler_t*) handler_data;
-  if (data->result != R_NilValue) {
-    R_ReleaseObject(data->result);
-    data->result = R_NilValue;
+  if (data->features->size() > data->committed_size) {
+    data->features->resize(data->committed_size);
   }
 }
 
@@ -235,13 +310,58 @@ void delete_vector_constructor(SEXP xptr) {
     }
 }
 
+void delete_geography_buffer(SEXP xptr) {
+    auto ptr = reinterpret_cast<GeographyBuffer*>(R_ExternalPtrAddr(xptr));
+    if (ptr != nullptr) {
+        delete ptr;
+    }
+}
+
+extern "C" SEXP c_s2_geography_buffer_new(void) {
+  CPP_START
+
+  SEXP buffer_xptr = PROTECT(R_MakeExternalPtr(new GeographyBuffer(), R_NilValue, R_NilValue));
+  R_RegisterCFinalizer(buffer_xptr, &delete_geography_buffer);
+  UNPROTECT(1);
+  return buffer_xptr;
+
+  CPP_END
+}
+
+// Creates the s2_geography vector from the features appended to a buffer
+// and empties the buffer
+extern "C" SEXP c_s2_geography_buffer_finish(SEXP buffer_xptr, SEXP arena_sexp) {
+  CPP_START
+
+  auto buffer = reinterpret_cast<GeographyBuffer*>(R_ExternalPtrAddr(buffer_xptr));
+  SEXP result = PROTECT(geography_vector(*buffer, arena_sexp));
+  buffer->clear();
+  buffer->shrink_to_fit();
+  UNPROTECT(1);
+  return result;
+
+  CPP_END
+}
+
+extern "C" SEXP c_s2_geography_buffer_size(SEXP buffer_xptr) {
+  auto buffer = reinterpret_cast<GeographyBuffer*>(R_ExternalPtrAddr(buffer_xptr));
+  return Rf_ScalarReal(buffer->size());
+}
+
+// With buffer_xptr = NULL, the writer reads features into its own buffer and
+// returns them as an s2_geography vector. Otherwise, features are appended
+// to buffer_xptr and the result of the handler is NULL.
 extern "C" SEXP c_s2_geography_writer_new(SEXP oriented_sexp, SEXP check_sexp,
                                           SEXP projection_xptr,
-                                          SEXP tessellate_tolerance_sexp) {
+                                          SEXP tessellate_tolerance_sexp,
+                                          SEXP num_threads_sexp, SEXP arena_sexp,
+                                          SEXP buffer_xptr) {
   CPP_START
 
   int oriented = LOGICAL(oriented_sexp)[0];
   int check = LOGICAL(check_sexp)[0];
+  int num_threads = INTEGER(num_threads_sexp)[0];
+  int arena = LOGICAL(arena_sexp)[0];
   S2::Projection* projection = NULL;
   if (projection_xptr != R_NilValue) {
     projection = reinterpret_cast<S2::Projection*>(R_ExternalPtrAddr(projection_xptr));
@@ -250,14 +370,24 @@ extern "C" SEXP c_s2_geography_writer_new(SEXP oriented_sexp, SEXP check_sexp,
 
   s2geography::util::Constructor::Options options;
   options.set_oriented(oriented);
-  options.set_check(check);
+  // checks are run for all features at once in builder_vector_end()
+  options.set_check(false);
   options.set_projection(projection);
   if (tessellate_tolerance != R_PosInf) {
     options.set_tessellate_tolerance(S1Angle::Radians(tessellate_tolerance));
   }
 
+  int append = buffer_xptr != R_NilValue;
+  if (!append) {
+    buffer_xptr = c_s2_geography_buffer_new();
+  }
+  PROTECT(buffer_xptr);
+  auto features = reinterpret_cast<GeographyBuffer*>(R_ExternalPtrAddr(buffer_xptr));
+
+  // the buffer is the tag of the builder pointer so that it is kept alive
+  // by the handler
   auto builder = new s2geography::util::FeatureConstructor(options);
-  SEXP builder_xptr = PROTECT(R_MakeExternalPtr(builder, R_NilValue, R_NilValue));
+  SEXP builder_xptr = PROTECT(R_MakeExternalPtr(builder, buffer_xptr, R_NilValue));
   R_RegisterCFinalizer(builder_xptr, &delete_vector_constructor);
 
   wk_handler_t* handler = wk_handler_create();
@@ -289,8 +419,13 @@ extern "C" SEXP c_s2_geography_writer_new(SEXP oriented_sexp, SEXP check_sexp,
   }
 
   data->coord_size = 2;
+  data->check = check;
+  data->num_threads = num_threads;
+  data->arena = arena;
+  data->append = append;
   data->builder = builder;
-  data->result = R_NilValue;
+  data->features = features;
+  data->committed_size = 0;
   memset(data->cpp_exception_error, 0, 8096);
 
   handler->handler_data = data;
@@ -299,12 +434,331 @@ extern "C" SEXP c_s2_geography_writer_new(SEXP oriented_sexp, SEXP check_sexp,
   // which guarnatees that it will not be garbage collected until
   // this object is garbage collected
   SEXP handler_xptr = wk_handler_create_xptr(handler, builder_xptr, projection_xptr);
-  UNPROTECT(1);
+  UNPROTECT(2);
   return handler_xptr;
 
   CPP_END
 }
 
+static s2geography::util::Constructor::Options constructor_options(SEXP oriented_sexp,
+                                                                   SEXP check_sexp,
+                                                                   SEXP projection_xptr,
+                                                                   SEXP tessellate_tolerance_sexp) {
+  int oriented = LOGICAL(oriented_sexp)[0];
+  int check = LOGICAL(check_sexp)[0];
+  S2::Projection* projection = NULL;
+  if (projection_xptr != R_NilValue) {
+    projection = reinterpret_cast<S2::Projection*>(R_ExternalPtrAddr(projection_xptr));
+  }
+  double tessellate_tolerance = REAL(tessellate_tolerance_sexp)[0];
+
+  s2geography::util::Constructor::Options options;
+  options.set_oriented(oriented);
+  options.set_check(check);
+  options.set_projection(projection);
+  if (tessellate_tolerance != R_PosInf) {
+    options.set_tessellate_tolerance(S1Angle::Radians(tessellate_tolerance));
+  }
+
+  return options;
+}
+
+// Reading WKB through the wk handler interface above calls the builder once
+// per coordinate. This version reads each coordinate sequence in one go
+// and, because features are independent, can parse them in parallel with
+// one constructor per thread. Only the final wrapping of the results in
+// external pointers happens on the main thread.
+extern "C" SEXP c_s2_geography_from_wkb(SEXP wkb, SEXP oriented_sexp, SEXP check_sexp,
+                                        SEXP projection_xptr,
+                                        SEXP tessellate_tolerance_sexp,
+                                        SEXP num_threads_sexp, SEXP arena_sexp) {
+  CPP_START
+
+  R_xlen_t n = Rf_xlength(wkb);
+  std::vector<const uint8_t*> data(n);
+  std::vector<int64_t> sizes(n);
+  for (R_xlen_t i = 0; i < n; i++) {
+    SEXP item = VECTOR_ELT(wkb, i);
+    if (item == R_NilValue) {
+      data[i] = nullptr;
+      sizes[i] = 0;
+    } else if (TYPEOF(item) == RAWSXP) {
+      data[i] = RAW(item);
+      sizes[i] = Rf_xlength(item);
+    } else {
+      throw std::runtime_error("Can't read WKB from an object that is not a raw vector or NULL");
+    }
+  }
+
+  s2geography::util::Constructor::Options options = constructor_options(
+    oriented_sexp, check_sexp, projection_xptr, tessellate_tolerance_sexp);
+  int num_threads = s2_parallel_num_threads(INTEGER(num_threads_sexp)[0], n);
+
+  std::vector<std::unique_ptr<s2geography::Geography>> features(n);
+  s2_parallel_for(n, num_threads, [&](int thread_id, int64_t begin, int64_t end) {
+    s2geography::util::FeatureConstructor builder(options);
+    s2geography::util::WKBReader reader(&builder);
+
+    for (int64_t i = begin; i < end; i++) {
+      if (data[i] == nullptr) {
+        continue;
+      }
+
+      try {
+        builder.feat_start();
+        reader.ReadGeometry(data[i], sizes[i]);
+        features[i] = builder.finish_feature();
+      } catch (std::exception& e) {
+        throw_feature_error(i, e);
+      }
+    }
+  });
+
+  return geography_vector(features, arena_sexp);
+
+  CPP_END
+}
+
+// Reads a geoarrow-encoded struct ArrowArray (owned by the caller) into an
+// s2_geography vector, in parallel like c_s2_geography_from_wkb()
+extern "C" SEXP c_s2_geography_from_geoarrow(SEXP array_xptr, SEXP schema_xptr,
+                                             SEXP oriented_sexp, SEXP check_sexp,
+                                             SEXP projection_xptr, SEXP planar_sexp,
+                                             SEXP tessellate_tolerance_sexp,
+                                             SEXP num_threads_sexp, SEXP arena_sexp) {
+  CPP_START
+
+  auto schema = reinterpret_cast<struct ArrowSchema*>(R_ExternalPtrAddr(schema_xptr));
+  auto array = reinterpret_cast<struct ArrowArray*>(R_ExternalPtrAddr(array_xptr));
+  if (schema == nullptr || schema->release == nullptr) {
+    throw std::runtime_error("schema is not a valid struct ArrowSchema");
+  }
+  if (array == nullptr || array->release == nullptr) {
+    throw std::runtime_error("array is not a valid struct ArrowArray");
+  }
+
+  // validate the schema and array before starting any threads
+  s2geography::Handler handler;
+  s2geography::util::GeoArrowReader reader(&handler);
+  reader.Init(schema);
+  reader.SetArray(array);
+  int64_t n = reader.length();
+
+  // planar = NA uses the edge type declared by the schema (spherical if
+  // it doesn't declare one); otherwise it must agree with the schema
+  using Edges = s2geography::util::GeoArrowReader::Edges;
+  int planar = LOGICAL(planar_sexp)[0];
+  if (planar == NA_LOGICAL) {
+    planar = reader.edges() == Edges::PLANAR;
+  } else if (planar && reader.edges() == Edges::SPHERICAL) {
+    throw std::runtime_error("Can't import geoarrow array with spherical edges using planar = TRUE");
+  } else if (!planar && reader.edges() == Edges::PLANAR) {
+    throw std::runtime_error("Can't import geoarrow array with planar edges using planar = FALSE");
+  }
+
+  s2geography::util::Constructor::Options options = constructor_options(
+    oriented_sexp, check_sexp, projection_xptr, tessellate_tolerance_sexp);
+  if (!planar) {
+    options.set_tessellate_tolerance(S1Angle::Infinity());
+  }
+  int num_threads = s2_parallel_num_threads(INTEGER(num_threads_sexp)[0], n);
+
+  std::vector<std::unique_ptr<s2geography::Geography>> features(n);
+  s2_parallel_for(n, num_threads, [&](int thread_id, int64_t begin, int64_t end) {
+    s2geography::util::FeatureConstructor builder(options);
+    s2geography::util::GeoArrowReader reader(&builder);
+    reader.Init(schema);
+    reader.SetArray(array);
+
+    for (int64_t i = begin; i < end; i++) {
+      if (reader.IsNull(i)) {
+        continue;
+      }
+
+      try {
+        builder.feat_start();
+        reader.ReadGeometry(i);
+        features[i] = builder.finish_feature();
+      } catch (std::exception& e) {
+        throw_feature_error(i, e);
+      }
+    }
+  });
+
+  return geography_vector(features, arena_sexp);
+
+  CPP_END
+}
+
+// Writes an s2_geography vector to a geoarrow-encoded array. The output
+// struct ArrowSchema and struct ArrowArray are allocated by the caller
+// (e.g., nanoarrow::nanoarrow_allocate_array()) and must be released.
+extern "C" SEXP c_s2_geography_to_geoarrow(SEXP geog, SEXP array_xptr, SEXP schema_xptr,
+                                           SEXP geometry_type_sexp,
+                                           SEXP projection_xptr,
+                                           SEXP tessellate_tolerance_sexp) {
+  CPP_START
+
+  using s2geography::util::GeometryType;
+  using s2geography::util::GeoArrowWriter;
+
+  auto schema = reinterpret_cast<struct ArrowSchema*>(R_ExternalPtrAddr(schema_xptr));
+  auto array = reinterpret_cast<struct ArrowArray*>(R_ExternalPtrAddr(array_xptr));
+  if (schema == nullptr || schema->release != nullptr) {
+    throw std::runtime_error("schema must be an external pointer to a released struct ArrowSchema");
+  }
+  if (array == nullptr || array->release != nullptr) {
+    throw std::runtime_error("array must be an external pointer to a released struct ArrowArray");
+  }
+
+  R_xlen_t n = Rf_xlength(geog);
+  std::vector<const s2geography::Geography*> features(n);
+  for (R_xlen_t i = 0; i < n; i++) {
+    SEXP item = VECTOR_ELT(geog, i);
+    if (item == R_NilValue) {
+      features[i] = nullptr;
+    } else {
+      features[i] = &reinterpret_cast<RGeography*>(R_ExternalPtrAddr(item))->Geog();
+    }
+  }
+
+  // If the geometry type wasn't specified, use the simplest one that can
+  // represent every feature (e.g., POLYGON + MULTIPOLYGON -> MULTIPOLYGON)
+  auto geometry_type = static_cast<GeometryType>(INTEGER(geometry_type_sexp)[0]);
+  if (geometry_type == GeometryType::GEOMETRY_TYPE_UNKNOWN) {
+    for (const s2geography::Geography* feature : features) {
+      if (feature == nullptr) {
+        continue;
+      }
+
+      GeometryType feature_type = GeoArrowWriter::FeatureGeometryType(*feature);
+      if (feature_type == GeometryType::GEOMETRY_TYPE_UNKNOWN ||
+          feature_type == geometry_type) {
+        continue;
+      } else if (feature_type == GeometryType::GEOMETRYCOLLECTION) {
+        throw std::runtime_error("Can't export GEOMETRYCOLLECTION to a geoarrow array");
+      } else if (geometry_type == GeometryType::GEOMETRY_TYPE_UNKNOWN) {
+        geometry_type = feature_type;
+      } else if (((geometry_type - 1) % 3) == ((feature_type - 1) % 3)) {
+        geometry_type = static_cast<GeometryType>(((feature_type - 1) % 3) + 4);
+      } else {
+        throw std::runtime_error("Can't export mixed geometry types to a geoarrow array");
+      }
+    }
+
+    if (geometry_type == GeometryType::GEOMETRY_TYPE_UNKNOWN) {
+      geometry_type = GeometryType::POINT;
+    }
+  }
+
+  s2geography::util::Constructor::Options options;
+  options.set_projection(reinterpret_cast<S2::Projection*>(R_ExternalPtrAddr(projection_xptr)));
+  double tessellate_tolerance = REAL(tessellate_tolerance_sexp)[0];
+  if (tessellate_tolerance != R_PosInf) {
+    options.set_tessellate_tolerance(S1Angle::Radians(tessellate_tolerance));
+  }
+
+  GeoArrowWriter writer(geometry_type, options);
+  for (R_xlen_t i = 0; i < n; i++) {
+    if (features[i] == nullptr) {
+      writer.AppendNull();
+    } else {
+      writer.Append(*features[i]);
+    }
+  }
+
+  writer.InitSchema(schema);
+  writer.Finish(array);
+  return R_NilValue;
+
+  CPP_END
+}
+
+// Encodes each feature using S2's native encodings (optionally including
+// the prebuilt shape index) so that geographies can be saved or sent to
+// another process without a round trip through WKB
+extern "C" SEXP c_s2_geography_serialize(SEXP geog, SEXP index_sexp) {
+  CPP_START
+
+  int include_index = LOGICAL(index_sexp)[0];
+  R_xlen_t n = Rf_xlength(geog);
+  SEXP result = PROTECT(Rf_allocVector(VECSXP, n));
+
+  Encoder encoder;
+  for (R_xlen_t i = 0; i < n; i++) {
+    SEXP item = VECTOR_ELT(geog, i);
+    if (item == R_NilValue) {
+      continue;
+    }
+
+    RGeography* feature = reinterpret_cast<RGeography*>(R_ExternalPtrAddr(item));
+    encoder.clear();
+    if (include_index) {
+      s2geography::util::EncodeGeography(feature->Geog(), &encoder, &feature->Index());
+    } else {
+      s2geography::util::EncodeGeography(feature->Geog(), &encoder);
+    }
+
+    SEXP item_raw = PROTECT(Rf_allocVector(RAWSXP, encoder.length()));
+    memcpy(RAW(item_raw), encoder.base(), encoder.length());
+    SET_VECTOR_ELT(result, i, item_raw);
+    UNPROTECT(1);
+  }
+
+  UNPROTECT(1);
+  return result;
+
+  CPP_END
+}
+
+// Decodes the output of c_s2_geography_serialize() in parallel. Features
+// are not re-validated and a shape index, if present, is restored without
+// rebuilding it.
+extern "C" SEXP c_s2_geography_unserialize(SEXP x, SEXP num_threads_sexp, SEXP arena_sexp) {
+  CPP_START
+
+  R_xlen_t n = Rf_xlength(x);
+  std::vector<const uint8_t*> data(n);
+  std::vector<int64_t> sizes(n);
+  for (R_xlen_t i = 0; i < n; i++) {
+    SEXP item = VECTOR_ELT(x, i);
+    if (item == R_NilValue) {
+      data[i] = nullptr;
+      sizes[i] = 0;
+    } else if (TYPEOF(item) == RAWSXP) {
+      data[i] = RAW(item);
+      sizes[i] = Rf_xlength(item);
+    } else {
+      throw std::runtime_error("Can't unserialize an object that is not a raw vector or NULL");
+    }
+  }
+
+  int num_threads = s2_parallel_num_threads(INTEGER(num_threads_sexp)[0], n);
+
+  std::vector<std::unique_ptr<RGeography>> features(n);
+  s2_parallel_for(n, num_threads, [&](int thread_id, int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      if (data[i] == nullptr) {
+        continue;
+      }
+
+      try {
+        Decoder decoder(data[i], sizes[i]);
+        std::unique_ptr<s2geography::ShapeIndexGeography> index;
+        std::unique_ptr<s2geography::Geography> geog =
+          s2geography::util::DecodeGeography(&decoder, &index);
+        features[i] = absl::make_unique<RGeography>(std::move(geog), std::move(index));
+      } catch (std::exception& e) {
+        throw_feature_error(i, e);
+      }
+    }
+  });
+
+  return geography_vector(features, arena_sexp);
+
+  CPP_END
+}
+
 // The following defines exporting...it will hopefully be subsumed by a more general
 // approach supported by geoarrow and/or s2geography
 
@@ -710,6 +1164,12 @@ int handle_polygon(const s2geography::PolygonGeography& geog,
   return WK_CONTINUE;
 }
 
+template <typename EdgeExporterT>
+int handle_feature(const s2geography::Geography& geog,
+                   EdgeExporterT* exporter,
+                   wk_handler_t* handler,
+                   uint32_t part_id);
+
 template <typename EdgeExporterT>
 int handle_collection(const s2geography::GeographyCollection& geog,
                       EdgeExporterT* exporter,
@@ -724,37 +1184,64 @@ int handle_collection(const s2geography::GeographyCollection& geog,
 
   HANDLE_OR_RETURN(handler->geometry_start(&meta, part_id, handler->handler_data));
   for (size_t i = 0; i < geog.Features().size(); i++) {
-    const s2geography::Geography* child_ptr = geog.Features()[i].get();
+    HANDLE_OR_RETURN(handle_feature<EdgeExporterT>(*geog.Features()[i], exporter, handler, i));
+  }
+  HANDLE_OR_RETURN(handler->geometry_end(&meta, part_id, handler->handler_data));
 
-    auto child_point = dynamic_cast<const s2geography::PointGeography*>(child_ptr);
-    if (child_point != nullptr) {
-      HANDLE_OR_RETURN(handle_points<EdgeExporterT>(*child_point, exporter, handler, i));
-      continue;
-    }
+  return WK_CONTINUE;
+}
 
-    auto child_polyline = dynamic_cast<const s2geography::PolylineGeography*>(child_ptr);
-    if (child_polyline != nullptr) {
-      HANDLE_OR_RETURN(handle_polylines<EdgeExporterT>(*child_polyline, exporter, handler, i));
-      continue;
-    }
+// Dispatches a feature to the handle_*() function for its concrete type
+// using s2geography::VisitGeography(), which switches on Geography::kind()
+template <typename EdgeExporterT>
+class FeatureVisitor {
+public:
+  FeatureVisitor(EdgeExporterT* exporter, wk_handler_t* handler, uint32_t part_id):
+    exporter_(exporter), handler_(handler), part_id_(part_id) {}
 
-    auto child_polygon = dynamic_cast<const s2geography::PolygonGeography*>(child_ptr);
-    if (child_polygon != nullptr) {
-      HANDLE_OR_RETURN(handle_polygon<EdgeExporterT>(*child_polygon, exporter, handler, i));
-      continue;
-    }
+  int operator()(const s2geography::PointGeography& geog) {
+    return handle_points<EdgeExporterT>(geog, exporter_, handler_, part_id_);
+  }
 
-    auto child_collection = dynamic_cast<const s2geography::GeographyCollection*>(child_ptr);
-    if (child_collection != nullptr) {
-      HANDLE_OR_RETURN(handle_collection<EdgeExporterT>(*child_collection, exporter, handler, i));
-      continue;
+  int operator()(const s2geography::PolylineGeography& geog) {
+    return handle_polylines<EdgeExporterT>(geog, exporter_, handler_, part_id_);
+  }
+
+  int operator()(const s2geography::PolygonGeography& geog) {
+    return handle_polygon<EdgeExporterT>(geog, exporter_, handler_, part_id_);
+  }
+
+  int operator()(const s2geography::GeographyCollection& geog) {
+    return handle_collection<EdgeExporterT>(geog, exporter_, handler_, part_id_);
+  }
+
+  // Other subclasses (e.g., features of a geography store) are only
+  // defined by their shapes and need to be rebuilt before they can be
+  // exported as simple features
+  int operator()(const s2geography::Geography& geog) {
+    std::unique_ptr<s2geography::Geography> rebuilt;
+    try {
+      rebuilt = s2geography::s2_rebuild(geog, s2geography::GlobalOptions());
+    } catch (std::exception& e) {
+      return handler_->error(e.what(), handler_->handler_data);
     }
 
-    return handler->error("Unsupported S2Geography subclass", handler->handler_data);
+    return s2geography::VisitGeography(*rebuilt, *this);
   }
-  HANDLE_OR_RETURN(handler->geometry_end(&meta, part_id, handler->handler_data));
 
-  return WK_CONTINUE;
+private:
+  EdgeExporterT* exporter_;
+  wk_handler_t* handler_;
+  uint32_t part_id_;
+};
+
+template <typename EdgeExporterT>
+int handle_feature(const s2geography::Geography& geog,
+                   EdgeExporterT* exporter,
+                   wk_handler_t* handler,
+                   uint32_t part_id) {
+  return s2geography::VisitGeography(
+    geog, FeatureVisitor<EdgeExporterT>(exporter, handler, part_id));
 }
 
 template <typename EdgeExporterT>
@@ -782,28 +1269,8 @@ SEXP handle_geography_templ(SEXP data, EdgeExporterT* exporter, wk_handler_t* ha
           auto item_ptr = reinterpret_cast<RGeography*>(R_ExternalPtrAddr(item));
           const s2geography::Geography* geog_ptr = &item_ptr->Geog();
 
-          auto child_point = dynamic_cast<const s2geography::PointGeography*>(geog_ptr);
-          if (child_point != nullptr) {
-            HANDLE_CONTINUE_OR_BREAK(handle_points<EdgeExporterT>(*child_point, exporter, handler));
-          } else {
-            auto child_polyline = dynamic_cast<const s2geography::PolylineGeography*>(geog_ptr);
-            if (child_polyline != nullptr) {
-              HANDLE_CONTINUE_OR_BREAK(handle_polylines<EdgeExporterT>(*child_polyline, exporter, handler));
-            } else {
-              auto child_polygon = dynamic_cast<const s2geography::PolygonGeography*>(geog_ptr);
-              if (child_polygon != nullptr) {
-                HANDLE_CONTINUE_OR_BREAK(handle_polygon<EdgeExporterT>(*child_polygon, exporter, handler));
-              } else {
-                auto child_collection = dynamic_cast<const s2geography::GeographyCollection*>(geog_ptr);
-                if (child_collection != nullptr) {
-                  HANDLE_CONTINUE_OR_BREAK(handle_collection<EdgeExporterT>(*child_collection, exporter, handler));
-                } else {
-                  HANDLE_CONTINUE_OR_BREAK(
-                    handler->error("Unsupported S2Geography subclass", handler->handler_data));
-                }
-              }
-            }
-          }
+          HANDLE_CONTINUE_OR_BREAK(
+            handle_feature<EdgeExporterT>(*geog_ptr, exporter, handler, WK_PART_ID_NONE));
         }
 
         if (handler->feature_end(&vector_meta, i, handler->handler_data) == WK_ABORT) {
@@ -857,21 +1324,445 @@ extern "C" SEXP c_s2_handle_geography(SEXP data, SEXP handler_xptr) {
     return wk_handler_run_xptr(&handle_geography, data, handler_xptr);
 }
 
+// Tessellating is much more expensive than projecting a coordinate, so
+// tessellated export happens in two steps: features are projected and
+// tessellated on worker threads into a compact buffer of handler calls
+// (one per thread, reused across batches), and the buffers are replayed
+// into the handler on the calling thread in feature order. Compared to the
+// TessellatingExporter, this also means that the sizes passed to the
+// handler are the number of coordinates after tessellation.
+class TessellatedFeatureBuffer {
+public:
+  TessellatedFeatureBuffer(const s2geography::util::Constructor::Options& options):
+    options_(options),
+    tessellator_(options.projection(), options.tessellate_tolerance()),
+    depth_(0), max_depth_(0) {}
+
+  void clear() {
+    events_.clear();
+    coords_.clear();
+    errors_.clear();
+    feature_events_.clear();
+  }
+
+  int64_t num_features() const {
+    return feature_events_.size();
+  }
+
+  void append_null_feature() {
+    feature_events_.push_back(events_.size());
+    push_event(NULL_FEATURE);
+  }
+
+  // Errors can't be reported to the handler from a worker thread, so they
+  // are recorded and passed to handler->error() when the feature is replayed
+  void append_feature(const s2geography::Geography& geog) {
+    feature_events_.push_back(events_.size());
+    depth_ = 0;
+
+    try {
+      s2geography::VisitGeography(geog, Writer(this, WK_PART_ID_NONE));
+    } catch (std::exception& e) {
+      push_event(FEATURE_ERROR, 0, 0, errors_.size());
+      errors_.push_back(e.what());
+    }
+  }
+
+  int replay_feature(int64_t i, wk_handler_t* handler) {
+    int64_t begin = feature_events_[i];
+    int64_t end = (i + 1) < num_features() ? feature_events_[i + 1] : events_.size();
+
+    // meta must remain valid between geometry_start() and geometry_end()
+    if (metas_.size() < static_cast<size_t>(max_depth_)) {
+      metas_.resize(max_depth_);
+    }
+
+    int result;
+    int depth = -1;
+    for (int64_t j = begin; j < end; j++) {
+      const Event& event = events_[j];
+      switch (event.type) {
+      case NULL_FEATURE:
+        HANDLE_OR_RETURN(handler->null_feature(handler->handler_data));
+        break;
+      case GEOMETRY_START:
+        depth++;
+        WK_META_RESET(metas_[depth], event.geometry_type);
+        metas_[depth].size = event.size;
+        HANDLE_OR_RETURN(handler->geometry_start(&metas_[depth], event.part_id, handler->handler_data));
+        break;
+      case GEOMETRY_END:
+        HANDLE_OR_RETURN(handler->geometry_end(&metas_[depth], event.part_id, handler->handler_data));
+        depth--;
+        break;
+      case RING_START:
+        HANDLE_OR_RETURN(handler->ring_start(&metas_[depth], event.size, event.part_id, handler->handler_data));
+        break;
+      case RING_END:
+        HANDLE_OR_RETURN(handler->ring_end(&metas_[depth], event.size, event.part_id, handler->handler_data));
+        break;
+      case COORDS:
+        for (int64_t k = event.begin; k < event.end; k++) {
+          HANDLE_OR_RETURN(handler->coord(&metas_[depth], coords_.data() + (k * 2), k - event.begin,
+                                          handler->handler_data));
+        }
+        break;
+      case FEATURE_ERROR:
+        return handler->error(errors_[event.begin].c_str(), handler->handler_data);
+      }
+    }
+
+    return WK_CONTINUE;
+  }
+
+private:
+  enum EventType {
+    NULL_FEATURE,
+    GEOMETRY_START,
+    GEOMETRY_END,
+    RING_START,
+    RING_END,
+    COORDS,
+    FEATURE_ERROR
+  };
+
+  struct Event {
+    EventType type;
+    uint32_t geometry_type;
+    uint32_t size;
+    uint32_t part_id;
+    // coordinate indices for COORDS or the index of the message for FEATURE_ERROR
+    int64_t begin;
+    int64_t end;
+  };
+
+  class Writer {
+  public:
+    Writer(TessellatedFeatureBuffer* buffer, uint32_t part_id): buffer_(buffer), part_id_(part_id) {}
+
+    void operator()(const s2geography::PointGeography& geog) {
+      buffer_->write_points(geog, part_id_);
+    }
+
+    void operator()(const s2geography::PolylineGeography& geog) {
+      buffer_->write_polylines(geog, part_id_);
+    }
+
+    void operator()(const s2geography::PolygonGeography& geog) {
+      buffer_->write_polygon(geog, part_id_);
+    }
+
+    void operator()(const s2geography::GeographyCollection& geog) {
+      buffer_->write_collection(geog, part_id_);
+    }
+
+    void operator()(const s2geography::Geography& geog) {
+      std::unique_ptr<s2geography::Geography> rebuilt =
+        s2geography::s2_rebuild(geog, s2geography::GlobalOptions());
+      s2geography::VisitGeography(*rebuilt, *this);
+    }
+
+  private:
+    TessellatedFeatureBuffer* buffer_;
+    uint32_t part_id_;
+  };
+
+  s2geography::util::Constructor::Options options_;
+  S2EdgeTessellator tessellator_;
+  std::vector<R2Point> points_out_;
+  int depth_;
+  int max_depth_;
+
+  std::vector<Event> events_;
+  std::vector<double> coords_;
+  std::vector<std::string> errors_;
+  std::vector<int64_t> feature_events_;
+  std::vector<wk_meta_t> metas_;
+
+  int64_t push_event(EventType type, uint32_t size = 0, uint32_t part_id = 0,
+                     int64_t begin = 0, int64_t end = 0) {
+    events_.push_back({type, WK_GEOMETRY, size, part_id, begin, end});
+    return events_.size() - 1;
+  }
+
+  int64_t geometry_start(uint32_t geometry_type, uint32_t size, uint32_t part_id) {
+    depth_++;
+    max_depth_ = std::max(max_depth_, depth_);
+    int64_t event_id = push_event(GEOMETRY_START, size, part_id);
+    events_[event_id].geometry_type = geometry_type;
+    return event_id;
+  }
+
+  void geometry_end(uint32_t part_id) {
+    depth_--;
+    push_event(GEOMETRY_END, 0, part_id);
+  }
+
+  // Appends points_out_ (or all but its last point) as a single run
+  uint32_t write_points_out(size_t n) {
+    int64_t begin = coords_.size() / 2;
+    for (size_t i = 0; i < n; i++) {
+      coords_.push_back(points_out_[i].x());
+      coords_.push_back(points_out_[i].y());
+    }
+
+    if (n > 0) {
+      push_event(COORDS, 0, 0, begin, begin + n);
+    }
+
+    return n;
+  }
+
+  void write_point(const S2Point& point) {
+    points_out_.clear();
+    points_out_.push_back(options_.projection()->Project(point));
+    write_points_out(1);
+  }
+
+  void write_points(const s2geography::PointGeography& geog, uint32_t part_id) {
+    const std::vector<S2Point>& points = geog.Points();
+
+    if (points.size() == 0) {
+      geometry_start(WK_POINT, 0, part_id);
+      geometry_end(part_id);
+    } else if (points.size() == 1) {
+      geometry_start(WK_POINT, 1, part_id);
+      write_point(points[0]);
+      geometry_end(part_id);
+    } else {
+      geometry_start(WK_MULTIPOINT, points.size(), part_id);
+      for (size_t i = 0; i < points.size(); i++) {
+        geometry_start(WK_POINT, 1, i);
+        write_point(points[i]);
+        geometry_end(i);
+      }
+      geometry_end(part_id);
+    }
+  }
+
+  void write_linestring(const S2Polyline& poly, uint32_t part_id) {
+    int64_t start_id = geometry_start(WK_LINESTRING, 0, part_id);
+
+    points_out_.clear();
+    for (int j = 1; j < poly.num_vertices(); j++) {
+      tessellator_.AppendProjected(poly.vertex(j - 1), poly.vertex(j), &points_out_);
+    }
+
+    events_[start_id].size = write_points_out(points_out_.size());
+    geometry_end(part_id);
+  }
+
+  void write_polylines(const s2geography::PolylineGeography& geog, uint32_t part_id) {
+    const auto& polylines = geog.Polylines();
+
+    if (polylines.size() == 0) {
+      geometry_start(WK_LINESTRING, 0, part_id);
+      geometry_end(part_id);
+    } else if (polylines.size() == 1) {
+      write_linestring(*polylines[0], part_id);
+    } else {
+      geometry_start(WK_MULTILINESTRING, polylines.size(), part_id);
+      for (size_t i = 0; i < polylines.size(); i++) {
+        write_linestring(*polylines[i], i);
+      }
+      geometry_end(part_id);
+    }
+  }
+
+  // Holes are written in reverse order; the last coordinate is the
+  // (unwrapped) projection of the first vertex so that the ring is closed
+  void write_ring(const S2Loop& loop, bool reverse, uint32_t ring_id) {
+    int n = loop.num_vertices();
+    if (n == 0) {
+      throw std::runtime_error("Unexpected S2Loop with 0 vertices");
+    }
+
+    int64_t start_id = push_event(RING_START, 0, ring_id);
+
+    points_out_.clear();
+    for (int i = 0; i < n; i++) {
+      if (reverse) {
+        tessellator_.AppendProjected(loop.vertex(n - 1 - i), loop.vertex(2 * n - 2 - i), &points_out_);
+      } else {
+        tessellator_.AppendProjected(loop.vertex(i), loop.vertex(i + 1), &points_out_);
+      }
+    }
+
+    points_out_.back() = options_.projection()->Project(loop.vertex(reverse ? (n - 1) : 0));
+    uint32_t size = write_points_out(points_out_.size());
+
+    events_[start_id].size = size;
+    push_event(RING_END, size, ring_id);
+  }
+
+  void write_shell(const S2Polygon& poly, int loop_start, uint32_t part_id, uint32_t num_rings) {
+    const S2Loop* loop0 = poly.loop(loop_start);
+    geometry_start(WK_POLYGON, num_rings, part_id);
+    write_ring(*loop0, false, 0);
+
+    uint32_t ring_id = 1;
+    for (int j = loop_start + 1; j <= poly.GetLastDescendant(loop_start); j++) {
+      const S2Loop* loop = poly.loop(j);
+      if (loop->depth() == (loop0->depth() + 1)) {
+        write_ring(*loop, true, ring_id);
+        ring_id++;
+      }
+    }
+
+    geometry_end(part_id);
+  }
+
+  void write_polygon(const s2geography::PolygonGeography& geog, uint32_t part_id) {
+    const S2Polygon& poly = *geog.Polygon();
+
+    // find the outer shells (loop depth = 0, 2, 4, etc.) and count the
+    // number of rings in each
+    std::vector<int> outer_shell_loop_ids;
+    std::vector<uint32_t> outer_shell_loop_sizes;
+    for (int i = 0; i < poly.num_loops(); i++) {
+      const S2Loop* loop0 = poly.loop(i);
+      if ((loop0->depth() % 2) != 0) {
+        continue;
+      }
+
+      uint32_t num_loops = 1;
+      for (int j = i + 1; j <= poly.GetLastDescendant(i); j++) {
+        num_loops += poly.loop(j)->depth() == (loop0->depth() + 1);
+      }
+
+      outer_shell_loop_ids.push_back(i);
+      outer_shell_loop_sizes.push_back(num_loops);
+    }
+
+    if (outer_shell_loop_ids.size() == 0) {
+      geometry_start(WK_POLYGON, 0, part_id);
+      geometry_end(part_id);
+    } else if (outer_shell_loop_ids.size() == 1) {
+      write_shell(poly, outer_shell_loop_ids[0], part_id, outer_shell_loop_sizes[0]);
+    } else {
+      geometry_start(WK_MULTIPOLYGON, outer_shell_loop_ids.size(), part_id);
+      for (size_t i = 0; i < outer_shell_loop_ids.size(); i++) {
+        write_shell(poly, outer_shell_loop_ids[i], i, outer_shell_loop_sizes[i]);
+      }
+      geometry_end(part_id);
+    }
+  }
+
+  void write_collection(const s2geography::GeographyCollection& geog, uint32_t part_id) {
+    geometry_start(WK_GEOMETRYCOLLECTION, geog.Features().size(), part_id);
+    for (size_t i = 0; i < geog.Features().size(); i++) {
+      s2geography::VisitGeography(*geog.Features()[i], Writer(this, i));
+    }
+    geometry_end(part_id);
+  }
+};
+
+// Owns the per-thread buffers so that they are released if the handler
+// longjmps (e.g., from handler->error())
+class TessellatedExportState {
+public:
+  TessellatedExportState(const s2geography::util::Constructor::Options& options, int num_threads) {
+    for (int i = 0; i < num_threads; i++) {
+      buffers.push_back(absl::make_unique<TessellatedFeatureBuffer>(options));
+    }
+  }
+
+  std::vector<std::unique_ptr<TessellatedFeatureBuffer>> buffers;
+  std::vector<const s2geography::Geography*> features;
+};
+
+// The number of features per thread that are tessellated before being
+// passed to the handler
+static const R_xlen_t kTessellateBatchSize = 1024;
+
 SEXP handle_geography_tessellated(SEXP data, wk_handler_t* handler) {
   SEXP projection_xptr = Rf_getAttrib(data, Rf_install("s2_projection"));
   auto projection = reinterpret_cast<S2::Projection*>(R_ExternalPtrAddr(projection_xptr));
   SEXP tessellate_tolerance_sexp = Rf_getAttrib(data, Rf_install("s2_tessellate_tol"));
   double tessellate_tol = REAL(tessellate_tolerance_sexp)[0];
+  SEXP num_threads_sexp = Rf_getAttrib(data, Rf_install("s2_num_threads"));
 
   s2geography::util::Constructor::Options options;
   options.set_projection(projection);
   options.set_tessellate_tolerance(S1Angle::Radians(tessellate_tol));
 
-  auto exporter = new TessellatingExporter(options);
-  SEXP exporter_shelter = PROTECT(R_MakeExternalPtr(exporter, R_NilValue, R_NilValue));
-  R_RegisterCFinalizer(exporter_shelter, &finalize_cpp_xptr<TessellatingExporter>);
+  R_xlen_t n_features = Rf_xlength(data);
+  int num_threads = 1;
+  if (num_threads_sexp != R_NilValue) {
+    num_threads = s2_parallel_num_threads(INTEGER(num_threads_sexp)[0], n_features);
+  }
+
+  auto state = new TessellatedExportState(options, num_threads);
+  SEXP state_shelter = PROTECT(R_MakeExternalPtr(state, R_NilValue, R_NilValue));
+  R_RegisterCFinalizer(state_shelter, &finalize_cpp_xptr<TessellatedExportState>);
+
+  wk_vector_meta_t vector_meta;
+  WK_VECTOR_META_RESET(vector_meta, WK_GEOMETRY);
+  vector_meta.size = n_features;
+  vector_meta.flags |= WK_FLAG_DIMS_UNKNOWN;
+
+  if (handler->vector_start(&vector_meta, handler->handler_data) == WK_CONTINUE) {
+    int result = WK_CONTINUE;
+    R_xlen_t batch_size = kTessellateBatchSize * num_threads;
+
+    for (R_xlen_t batch_begin = 0; batch_begin < n_features; batch_begin += batch_size) {
+      R_xlen_t batch_end = std::min<R_xlen_t>(n_features, batch_begin + batch_size);
+
+      state->features.clear();
+      for (R_xlen_t i = batch_begin; i < batch_end; i++) {
+        SEXP item = VECTOR_ELT(data, i);
+        if (item == R_NilValue) {
+          state->features.push_back(nullptr);
+        } else {
+          auto item_ptr = reinterpret_cast<RGeography*>(R_ExternalPtrAddr(item));
+          state->features.push_back(&item_ptr->Geog());
+        }
+      }
+
+      // s2_parallel_for() gives each thread a contiguous chunk of features
+      // in thread_id order, so replaying the buffers in order preserves
+      // the order of the features
+      for (auto& buffer : state->buffers) {
+        buffer->clear();
+      }
+
+      try {
+        s2_parallel_for(batch_end - batch_begin, num_threads, [&](int thread_id, int64_t begin, int64_t end) {
+          TessellatedFeatureBuffer* buffer = state->buffers[thread_id].get();
+          for (int64_t i = begin; i < end; i++) {
+            if (state->features[i] == nullptr) {
+              buffer->append_null_feature();
+            } else {
+              buffer->append_feature(*state->features[i]);
+            }
+          }
+        });
+      } catch (std::exception& e) {
+        handler->error(e.what(), handler->handler_data);
+        break;
+      }
+
+      R_xlen_t feat_id = batch_begin;
+      for (auto& buffer : state->buffers) {
+        for (int64_t i = 0; i < buffer->num_features(); i++, feat_id++) {
+          result = handler->feature_start(&vector_meta, feat_id, handler->handler_data);
+          if (result == WK_ABORT_FEATURE) continue; else if (result == WK_ABORT) break;
+
+          result = buffer->replay_feature(i, handler);
+          if (result == WK_ABORT_FEATURE) continue; else if (result == WK_ABORT) break;
+
+          result = handler->feature_end(&vector_meta, feat_id, handler->handler_data);
+          if (result == WK_ABORT) break;
+        }
+
+        if (result == WK_ABORT) break;
+      }
 
-  SEXP result = PROTECT(handle_geography_templ<TessellatingExporter>(data, exporter, handler));
+      if (result == WK_ABORT) break;
+    }
+  }
+
+  SEXP result = PROTECT(handler->vector_end(&vector_meta, handler->handler_data));
   UNPROTECT(2);
   return result;
 }
@@ -923,6 +1814,122 @@ extern "C" SEXP c_s2_handle_geography_tessellated(SEXP data, SEXP handler_xptr)
     return wk_handler_run_xptr(&handle_geography_tessellated, data, handler_xptr);
 }
 
+// Cells are exported directly from their vertices without creating
+// an S2Polygon or RGeography for each feature. Because S2 cells are always
+// a single counter-clockwise loop, each cell is a single-ring polygon.
+template <typename EdgeExporterT>
+int handle_cell(const S2Cell& cell, EdgeExporterT* exporter, wk_handler_t* handler) {
+  int result;
+
+  wk_meta_t meta;
+  WK_META_RESET(meta, WK_POLYGON);
+  meta.size = 1;
+  exporter->set_meta_flags(&meta);
+
+  HANDLE_OR_RETURN(handler->geometry_start(&meta, WK_PART_ID_NONE, handler->handler_data));
+  HANDLE_OR_RETURN(handler->ring_start(&meta, 5, 0, handler->handler_data));
+
+  exporter->reset();
+  for (int k = 0; k < 4; k++) {
+    HANDLE_OR_RETURN(exporter->coord_in_series(&meta, cell.GetVertex(k), handler));
+  }
+  HANDLE_OR_RETURN(exporter->last_coord_in_loop(&meta, cell.GetVertex(0), handler));
+
+  HANDLE_OR_RETURN(handler->ring_end(&meta, 5, 0, handler->handler_data));
+  HANDLE_OR_RETURN(handler->geometry_end(&meta, WK_PART_ID_NONE, handler->handler_data));
+  return WK_CONTINUE;
+}
+
+template <typename EdgeExporterT>
+SEXP handle_cell_templ(SEXP data, EdgeExporterT* exporter, wk_handler_t* handler) {
+  R_xlen_t n_features = Rf_xlength(data);
+  const double* cell_double = REAL(data);
+  const uint64_t* cell_id = reinterpret_cast<const uint64_t*>(cell_double);
+
+  wk_vector_meta_t vector_meta;
+  WK_VECTOR_META_RESET(vector_meta, WK_POLYGON);
+  vector_meta.size = n_features;
+  exporter->set_vector_meta_flags(&vector_meta);
+
+  if (handler->vector_start(&vector_meta, handler->handler_data) == WK_CONTINUE) {
+    int result;
+
+    for (R_xlen_t i = 0; i < n_features; i++) {
+      HANDLE_CONTINUE_OR_BREAK(handler->feature_start(&vector_meta, i, handler->handler_data));
+
+      S2CellId cell(cell_id[i]);
+      if (R_IsNA(cell_double[i]) || !cell.is_valid()) {
+        HANDLE_CONTINUE_OR_BREAK(handler->null_feature(handler->handler_data));
+      } else {
+        HANDLE_CONTINUE_OR_BREAK(handle_cell<EdgeExporterT>(S2Cell(cell), exporter, handler));
+      }
+
+      if (handler->feature_end(&vector_meta, i, handler->handler_data) == WK_ABORT) {
+        break;
+      }
+    }
+  }
+
+  SEXP result = PROTECT(handler->vector_end(&vector_meta, handler->handler_data));
+  UNPROTECT(1);
+  return result;
+}
+
+SEXP handle_cell_polygon(SEXP data, wk_handler_t* handler) {
+  SEXP projection_xptr = Rf_getAttrib(data, Rf_install("s2_projection"));
+
+  SEXP result;
+
+  if (projection_xptr != R_NilValue) {
+    auto projection = reinterpret_cast<S2::Projection*>(R_ExternalPtrAddr(projection_xptr));
+    s2geography::util::Constructor::Options options;
+    options.set_projection(projection);
+
+    auto exporter = new SimpleExporter(options);
+    SEXP exporter_shelter = PROTECT(R_MakeExternalPtr(exporter, R_NilValue, R_NilValue));
+    R_RegisterCFinalizer(exporter_shelter, &finalize_cpp_xptr<SimpleExporter>);
+
+    result = PROTECT(handle_cell_templ<SimpleExporter>(data, exporter, handler));
+    UNPROTECT(2);
+  } else {
+    auto exporter = new S2Exporter();
+    SEXP exporter_shelter = PROTECT(R_MakeExternalPtr(exporter, R_NilValue, R_NilValue));
+    R_RegisterCFinalizer(exporter_shelter, &finalize_cpp_xptr<S2Exporter>);
+
+    result = PROTECT(handle_cell_templ<S2Exporter>(data, exporter, handler));
+    UNPROTECT(2);
+  }
+
+  return result;
+}
+
+extern "C" SEXP c_s2_handle_cell_polygon(SEXP data, SEXP handler_xptr) {
+    return wk_handler_run_xptr(&handle_cell_polygon, data, handler_xptr);
+}
+
+SEXP handle_cell_polygon_tessellated(SEXP data, wk_handler_t* handler) {
+  SEXP projection_xptr = Rf_getAttrib(data, Rf_install("s2_projection"));
+  auto projection = reinterpret_cast<S2::Projection*>(R_ExternalPtrAddr(projection_xptr));
+  SEXP tessellate_tolerance_sexp = Rf_getAttrib(data, Rf_install("s2_tessellate_tol"));
+  double tessellate_tol = REAL(tessellate_tolerance_sexp)[0];
+
+  s2geography::util::Constructor::Options options;
+  options.set_projection(projection);
+  options.set_tessellate_tolerance(S1Angle::Radians(tessellate_tol));
+
+  auto exporter = new TessellatingExporter(options);
+  SEXP exporter_shelter = PROTECT(R_MakeExternalPtr(exporter, R_NilValue, R_NilValue));
+  R_RegisterCFinalizer(exporter_shelter, &finalize_cpp_xptr<TessellatingExporter>);
+
+  SEXP result = PROTECT(handle_cell_templ<TessellatingExporter>(data, exporter, handler));
+  UNPROTECT(2);
+  return result;
+}
+
+extern "C" SEXP c_s2_handle_cell_polygon_tessellated(SEXP data, SEXP handler_xptr) {
+    return wk_handler_run_xptr(&handle_cell_polygon_tessellated, data, handler_xptr);
+}
+
 extern "C" SEXP c_s2_projection_plate_carree(SEXP x_scale_sexp) {
   double x_scale = REAL(x_scale_sexp)[0];
 
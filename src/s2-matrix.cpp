@@ -10,6 +10,9 @@
 #include "s2/s2shape_index_buffered_region.h"
 
 #include "geography-operator.h"
+#include "linear-reference-vector.h"
+#include "point-vector.h"
+#include "s2-parallel.h"
 #include "s2-options.h"
 
 #include <Rcpp.h>
@@ -35,6 +38,11 @@ public:
   }
 
   virtual void buildIndex(List geog2) {
+    buildGeographyIndex(geog2, geog2_index.get());
+    iterator = absl::make_unique<s2geography::GeographyIndex::Iterator>(geog2_index.get());
+  }
+
+  static void buildGeographyIndex(List geog2, s2geography::GeographyIndex* index) {
     for (R_xlen_t j = 0; j < geog2.size(); j++) {
       checkUserInterrupt();
       SEXP item2 = geog2[j];
@@ -45,25 +53,24 @@ public:
         Rcpp::stop("Missing `y` not allowed in binary indexed operators()");
       } else {
         Rcpp::XPtr<RGeography> feature2(item2);
-        geog2_index->Add(feature2->Geog(), j);
+        index->Add(feature2->Geog(), j);
       }
     }
-
-    iterator = absl::make_unique<s2geography::GeographyIndex::Iterator>(geog2_index.get());
   }
 };
 
 // -------- closest/farthest feature ----------
 
 // [[Rcpp::export]]
-IntegerVector cpp_s2_closest_feature(List geog1, List geog2) {
+IntegerVector cpp_s2_closest_feature(List geog1, List geog2, double maxError) {
 
   class Op: public IndexedBinaryGeographyOperator<IntegerVector, int> {
   public:
+    std::unique_ptr<S2ClosestEdgeQuery> query;
+
     int processFeature(Rcpp::XPtr<RGeography> feature, R_xlen_t i) {
-      S2ClosestEdgeQuery query(&geog2_index->ShapeIndex());
       S2ClosestEdgeQuery::ShapeIndexTarget target(&feature->Index().ShapeIndex());
-      const auto& result = query.FindClosestEdge(&target);
+      const auto& result = query->FindClosestEdge(&target);
       if (result.is_empty()) {
         return NA_INTEGER;
       } else {
@@ -75,9 +82,45 @@ IntegerVector cpp_s2_closest_feature(List geog1, List geog2) {
 
   Op op;
   op.buildIndex(geog2);
+  op.query = absl::make_unique<S2ClosestEdgeQuery>(&op.geog2_index->ShapeIndex());
+  op.query->mutable_options()->set_max_error(S1Angle::Radians(maxError));
   return op.processVector(geog1);
 }
 
+// Point vectors query the index of geog2 with a PointTarget for each point,
+// reusing a single query object
+// [[Rcpp::export]]
+IntegerVector cpp_s2_closest_feature_point_vector(List x, List geog2, double maxError) {
+  PointVector points(x);
+  s2geography::GeographyIndex geog2_index;
+  IndexedBinaryGeographyOperator<IntegerVector, int>::buildGeographyIndex(geog2, &geog2_index);
+
+  S2ClosestEdgeQuery query(&geog2_index.ShapeIndex());
+  query.mutable_options()->set_max_error(S1Angle::Radians(maxError));
+  IntegerVector output(points.size());
+
+  for (R_xlen_t i = 0; i < points.size(); i++) {
+    if ((i % 1000) == 0) {
+      checkUserInterrupt();
+    }
+
+    if (points.is_empty(i)) {
+      output[i] = NA_INTEGER;
+      continue;
+    }
+
+    S2ClosestEdgeQuery::PointTarget target(points.point(i));
+    const auto& result = query.FindClosestEdge(&target);
+    if (result.is_empty()) {
+      output[i] = NA_INTEGER;
+    } else {
+      output[i] = geog2_index.value(result.shape_id()) + 1;
+    }
+  }
+
+  return output;
+}
+
 // [[Rcpp::export]]
 IntegerVector cpp_s2_farthest_feature(List geog1, List geog2) {
 
@@ -292,26 +335,16 @@ List cpp_s2_equals_matrix(List geog1, List geog2, List s2options) {
 List cpp_s2_touches_matrix(List geog1, List geog2, List s2options) {
   class Op: public IndexedMatrixPredicateOperator {
   public:
-    Op(List s2options): IndexedMatrixPredicateOperator(s2options) {
-      this->closedOptions = this->options;
-      this->closedOptions.set_polygon_model(S2BooleanOperation::PolygonModel::CLOSED);
-      this->closedOptions.set_polyline_model(S2BooleanOperation::PolylineModel::CLOSED);
-
-      this->openOptions = this->options;
-      this->openOptions.set_polygon_model(S2BooleanOperation::PolygonModel::OPEN);
-      this->openOptions.set_polyline_model(S2BooleanOperation::PolylineModel::OPEN);
-    }
+    Op(List s2options): IndexedMatrixPredicateOperator(s2options), evaluator(this->options) {}
 
     bool actuallyIntersects(const s2geography::ShapeIndexGeography& index1,
                                   const s2geography::ShapeIndexGeography& index2,
                                   R_xlen_t i, R_xlen_t j) {
-      return s2geography::s2_intersects(index1, index2, this->closedOptions) &&
-        !s2geography::s2_intersects(index1, index2, this->openOptions);
+      return evaluator.Evaluate(index1, index2, s2geography::RelationEvaluator::kTouches) != 0;
     };
 
   private:
-    S2BooleanOperation::Options closedOptions;
-    S2BooleanOperation::Options openOptions;
+    s2geography::RelationEvaluator evaluator;
   };
 
   Op op(s2options);
@@ -429,6 +462,44 @@ List cpp_s2_dwithin_matrix(List geog1, List geog2, double distance) {
   return op.processVector(geog1);
 }
 
+// Instead of covering a buffered region for each feature, point vectors
+// find all edges of geog2 within distance of each point
+// [[Rcpp::export]]
+List cpp_s2_dwithin_matrix_point_vector(List x, List geog2, double distance) {
+  PointVector points(x);
+  s2geography::GeographyIndex geog2_index;
+  IndexedBinaryGeographyOperator<List, IntegerVector>::buildGeographyIndex(geog2, &geog2_index);
+
+  S2ClosestEdgeQuery query(&geog2_index.ShapeIndex());
+  query.mutable_options()->set_inclusive_max_distance(S1ChordAngle::Radians(distance));
+
+  std::vector<S2ClosestEdgeQuery::Result> results;
+  std::vector<int> indices;
+  List output(points.size());
+
+  for (R_xlen_t i = 0; i < points.size(); i++) {
+    if ((i % 1000) == 0) {
+      checkUserInterrupt();
+    }
+
+    indices.clear();
+    if (!points.is_empty(i)) {
+      S2ClosestEdgeQuery::PointTarget target(points.point(i));
+      query.FindClosestEdges(&target, &results);
+      for (const auto& result : results) {
+        indices.push_back(geog2_index.value(result.shape_id()) + 1);
+      }
+    }
+
+    // return sorted, unique integer vector
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+    output[i] = IntegerVector(indices.begin(), indices.end());
+  }
+
+  return output;
+}
+
 // ----------- distance matrix operators -------------------
 
 template<class MatrixType, class ScalarType>
@@ -473,17 +544,14 @@ public:
 };
 
 // [[Rcpp::export]]
-NumericMatrix cpp_s2_distance_matrix(List geog1, List geog2) {
+NumericMatrix cpp_s2_distance_matrix(List geog1, List geog2, double maxError) {
   class Op: public MatrixGeographyOperator<NumericMatrix, double> {
+  public:
+    Op(double maxError): query(maxError) {}
 
     double processFeature(XPtr<RGeography> feature1, XPtr<RGeography> feature2,
                           R_xlen_t i, R_xlen_t j) {
-      S2ClosestEdgeQuery query(&feature1->Index().ShapeIndex());
-      S2ClosestEdgeQuery::ShapeIndexTarget target(&feature2->Index().ShapeIndex());
-      const auto& result = query.FindClosestEdge(&target);
-
-      S1ChordAngle angle = result.distance();
-      double distance = angle.ToAngle().radians();
+      double distance = query.Distance(feature1->Index(), feature2->Index());
 
       if (distance == R_PosInf) {
         return NA_REAL;
@@ -491,24 +559,66 @@ NumericMatrix cpp_s2_distance_matrix(List geog1, List geog2) {
         return distance;
       }
     }
+
+  private:
+    // the query on feature1 is reused for each feature in a row
+    s2geography::PairwiseDistance query;
   };
 
-  Op op;
+  Op op(maxError);
   return op.processVector(geog1, geog2);
 }
 
+// Point vectors build one query per feature of geog2 (rather than per pair)
+// and fill the matrix one column at a time
+// [[Rcpp::export]]
+NumericMatrix cpp_s2_distance_matrix_point_vector(List x, List geog2, double maxError) {
+  PointVector points(x);
+  NumericMatrix output(points.size(), geog2.size());
+
+  for (R_xlen_t j = 0; j < geog2.size(); j++) {
+    checkUserInterrupt();
+
+    SEXP item2 = geog2[j];
+    if (item2 == R_NilValue) {
+      for (R_xlen_t i = 0; i < points.size(); i++) {
+        output(i, j) = NA_REAL;
+      }
+      continue;
+    }
+
+    XPtr<RGeography> feature2(item2);
+    S2ClosestEdgeQuery query(&feature2->Index().ShapeIndex());
+    query.mutable_options()->set_max_error(S1Angle::Radians(maxError));
+
+    for (R_xlen_t i = 0; i < points.size(); i++) {
+      if (points.is_empty(i)) {
+        output(i, j) = NA_REAL;
+        continue;
+      }
+
+      S2ClosestEdgeQuery::PointTarget target(points.point(i));
+      S1ChordAngle distance = query.GetDistance(&target);
+      if (distance.is_special()) {
+        output(i, j) = NA_REAL;
+      } else {
+        output(i, j) = distance.ToAngle().radians();
+      }
+    }
+  }
+
+  return output;
+}
+
 // [[Rcpp::export]]
-NumericMatrix cpp_s2_max_distance_matrix(List geog1, List geog2) {
+NumericMatrix cpp_s2_max_distance_matrix(List geog1, List geog2, double maxError) {
   class Op: public MatrixGeographyOperator<NumericMatrix, double> {
+  public:
+    Op(double maxError): query(maxError) {}
 
     double processFeature(XPtr<RGeography> feature1, XPtr<RGeography> feature2,
                           R_xlen_t i, R_xlen_t j) {
-      S2FurthestEdgeQuery query(&feature1->Index().ShapeIndex());
-      S2FurthestEdgeQuery::ShapeIndexTarget target(&feature2->Index().ShapeIndex());
-      const auto& result = query.FindFurthestEdge(&target);
-
-      S1ChordAngle angle = result.distance();
-      double distance = angle.ToAngle().radians();
+      double distance = query.MaxDistance(feature1->Index(), feature2->Index());
 
       // returns -1 if one of the indexes is empty
       // NA is more consistent with the BigQuery
@@ -519,12 +629,80 @@ NumericMatrix cpp_s2_max_distance_matrix(List geog1, List geog2) {
         return distance;
       }
     }
+
+  private:
+    s2geography::PairwiseMaxDistance query;
   };
 
-  Op op;
+  Op op(maxError);
   return op.processVector(geog1, geog2);
 }
 
+// Rows are computed in parallel; each feature is indexed once for the
+// whole matrix
+// [[Rcpp::export]]
+NumericMatrix cpp_s2_hausdorff_distance_matrix(List geog1, List geog2, bool directed,
+                                               double maxDistance, int numThreads) {
+  std::vector<const s2geography::ShapeIndexGeography*> index1 = RGeography::NonEmptyIndexes(geog1);
+  std::vector<const s2geography::ShapeIndexGeography*> index2 = RGeography::NonEmptyIndexes(geog2);
+
+  R_xlen_t nrow = geog1.size();
+  R_xlen_t ncol = geog2.size();
+  NumericMatrix output(nrow, ncol);
+  double* outputPtr = REAL(output);
+
+  s2_parallel_for(nrow, numThreads, [&](int threadId, int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      for (R_xlen_t j = 0; j < ncol; j++) {
+        double* value = outputPtr + i + j * nrow;
+        if (index1[i] == nullptr || index2[j] == nullptr || ISNAN(maxDistance)) {
+          *value = NA_REAL;
+        } else if (directed) {
+          *value = s2geography::s2_directed_hausdorff_distance(*index1[i], *index2[j], maxDistance);
+        } else {
+          *value = s2geography::s2_hausdorff_distance(*index1[i], *index2[j], maxDistance);
+        }
+      }
+    }
+  });
+
+  return output;
+}
+
+// [[Rcpp::export]]
+NumericMatrix cpp_s2_alignment_cost_matrix(List geog1, List geog2, int method, int numThreads) {
+  auto alignmentMethod = static_cast<s2geography::AlignmentMethod>(method);
+  LinearReferenceVector lines1(geog1, false, numThreads);
+  LinearReferenceVector lines2(geog2, false, numThreads);
+
+  R_xlen_t nrow = lines1.size();
+  R_xlen_t ncol = lines2.size();
+  NumericMatrix output(nrow, ncol);
+  double* outputPtr = REAL(output);
+
+  s2_parallel_for(nrow, numThreads, [&](int threadId, int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      const s2geography::LinearReference* reference1 = lines1.reference(i);
+      for (R_xlen_t j = 0; j < ncol; j++) {
+        const s2geography::LinearReference* reference2 = lines2.reference(j);
+        double* value = outputPtr + i + j * nrow;
+        if (lines1.feature(i) == nullptr || lines2.feature(j) == nullptr) {
+          *value = NA_REAL;
+        } else if (reference1 == nullptr || reference2 == nullptr ||
+                   reference1->is_empty() || reference2->is_empty()) {
+          *value = NAN;
+        } else {
+          *value = s2geography::s2_alignment_cost(
+            reference1->polyline(), reference2->polyline(), alignmentMethod
+          );
+        }
+      }
+    }
+  });
+
+  return output;
+}
+
 
 // ----------- brute force binary predicate operators (for testing) ------------------
 
@@ -0,0 +1,84 @@
+
+#ifndef S2_PARALLEL_H
+#define S2_PARALLEL_H
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+// Clamps a user-supplied number of threads to something that makes sense
+// for a job of size n. Values less than 1 (including NA_INTEGER) mean "use
+// a single thread".
+inline int s2_parallel_num_threads(int num_threads, int64_t n) {
+  if (num_threads < 1 || n < 2) {
+    return 1;
+  }
+
+  return static_cast<int>(std::min<int64_t>(num_threads, n));
+}
+
+// Calls fun(thread_id, begin, end) for contiguous chunks of [0, n) using
+// at most num_threads threads, where the calling thread processes the first
+// chunk. The thread_id (0 <= thread_id < num_threads) can be used to index
+// per-thread scratch space allocated before the call.
+//
+// Worker functions must not touch the R API: this includes allocating
+// R objects, Rcpp::checkUserInterrupt(), Rcpp::stop(), and lazily building
+// RGeography::Index() (which must be done before calling this function).
+// Read inputs from pointers obtained beforehand and write results into
+// preallocated buffers. If any worker throws, the first exception
+// (by thread_id) is rethrown on the calling thread after all workers
+// have finished.
+template <typename Fun>
+void s2_parallel_for(int64_t n, int num_threads, Fun fun) {
+  num_threads = s2_parallel_num_threads(num_threads, n);
+
+  if (num_threads == 1) {
+    fun(0, 0, n);
+    return;
+  }
+
+  int64_t chunk_size = (n + num_threads - 1) / num_threads;
+  std::vector<std::exception_ptr> errors(num_threads);
+
+  auto run_chunk = [&](int thread_id) {
+    int64_t begin = thread_id * chunk_size;
+    int64_t end = std::min<int64_t>(n, begin + chunk_size);
+
+    try {
+      if (begin < end) {
+        fun(thread_id, begin, end);
+      }
+    } catch (...) {
+      errors[thread_id] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(num_threads - 1);
+  for (int thread_id = 1; thread_id < num_threads; thread_id++) {
+    try {
+      workers.emplace_back(run_chunk, thread_id);
+    } catch (std::system_error& e) {
+      // if a thread can't be created, do the work on this one
+      run_chunk(thread_id);
+    }
+  }
+
+  run_chunk(0);
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  for (const auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+#endif
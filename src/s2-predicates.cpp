@@ -7,6 +7,7 @@
 #include "s2/s2shape_index_buffered_region.h"
 
 #include "geography-operator.h"
+#include "point-vector.h"
 #include "s2-options.h"
 
 #include <Rcpp.h>
@@ -69,30 +70,46 @@ LogicalVector cpp_s2_contains(List geog1, List geog2, List s2options) {
 LogicalVector cpp_s2_touches(List geog1, List geog2, List s2options) {
   class Op: public BinaryPredicateOperator {
   public:
-    Op(List s2options): BinaryPredicateOperator(s2options) {
-      this->closedOptions = this->options;
-      this->closedOptions.set_polygon_model(S2BooleanOperation::PolygonModel::CLOSED);
-      this->closedOptions.set_polyline_model(S2BooleanOperation::PolylineModel::CLOSED);
-
-      this->openOptions = this->options;
-      this->openOptions.set_polygon_model(S2BooleanOperation::PolygonModel::OPEN);
-      this->openOptions.set_polyline_model(S2BooleanOperation::PolylineModel::OPEN);
-    }
+    Op(List s2options): BinaryPredicateOperator(s2options), evaluator(this->options) {}
 
     int processFeature(XPtr<RGeography> feature1, XPtr<RGeography> feature2, R_xlen_t i) {
-      return s2geography::s2_intersects(feature1->Index(), feature2->Index(), this->closedOptions) &&
-        !s2geography::s2_intersects(feature1->Index(), feature2->Index(), this->openOptions);
+      return evaluator.Evaluate(
+        feature1->Index(), feature2->Index(),
+        s2geography::RelationEvaluator::kTouches
+      ) != 0;
     }
 
   private:
-    S2BooleanOperation::Options closedOptions;
-    S2BooleanOperation::Options openOptions;
+    s2geography::RelationEvaluator evaluator;
   };
 
   Op op(s2options);
   return op.processVector(geog1, geog2);
 }
 
+// Returns a bitmask of s2geography::RelationEvaluator::Relation values
+// so that several predicates can be evaluated for each pair at once
+// [[Rcpp::export]]
+IntegerVector cpp_s2_relations(List geog1, List geog2, int relations, List s2options) {
+  class Op: public BinaryGeographyOperator<IntegerVector, int> {
+  public:
+    Op(int relations, List s2options):
+      relations(relations),
+      evaluator(GeographyOperationOptions(s2options).booleanOperationOptions()) {}
+
+    int processFeature(XPtr<RGeography> feature1, XPtr<RGeography> feature2, R_xlen_t i) {
+      return evaluator.Evaluate(feature1->Index(), feature2->Index(), relations);
+    }
+
+  private:
+    uint32_t relations;
+    s2geography::RelationEvaluator evaluator;
+  };
+
+  Op op(relations, s2options);
+  return op.processVector(geog1, geog2);
+}
+
 // [[Rcpp::export]]
 LogicalVector cpp_s2_dwithin(List geog1, List geog2, NumericVector distance) {
   if (distance.size() != geog1.size())  {
@@ -122,6 +139,58 @@ LogicalVector cpp_s2_dwithin(List geog1, List geog2, NumericVector distance) {
   return op.processVector(geog1, geog2);
 }
 
+// Like cpp_s2_dwithin(), but x is a point vector and y is either a point
+// vector or a geography vector (see cpp_s2_distance_point_vector())
+// [[Rcpp::export]]
+LogicalVector cpp_s2_dwithin_point_vector(List x, List y, NumericVector distance) {
+  PointVector points(x);
+  if (distance.size() != points.size())  {
+    stop("Incompatible lengths"); // #nocov
+  }
+
+  LogicalVector output(points.size());
+
+  if (PointVector::is_geography(y)) {
+    RGeography* last_feature = nullptr;
+    std::unique_ptr<S2ClosestEdgeQuery> query;
+
+    for (R_xlen_t i = 0; i < points.size(); i++) {
+      if ((i % 1000) == 0) {
+        checkUserInterrupt();
+      }
+
+      SEXP item = y[i];
+      if (item == R_NilValue) {
+        output[i] = NA_LOGICAL;
+        continue;
+      } else if (points.is_empty(i)) {
+        output[i] = false;
+        continue;
+      }
+
+      XPtr<RGeography> feature(item);
+      if (feature.get() != last_feature) {
+        query = absl::make_unique<S2ClosestEdgeQuery>(&feature->Index().ShapeIndex());
+        last_feature = feature.get();
+      }
+
+      S2ClosestEdgeQuery::PointTarget target(points.point(i));
+      output[i] = query->IsDistanceLessOrEqual(&target, S1ChordAngle::Radians(distance[i]));
+    }
+  } else {
+    PointVector other(y);
+    for (R_xlen_t i = 0; i < points.size(); i++) {
+      if (points.is_empty(i) || other.is_empty(i)) {
+        output[i] = false;
+      } else {
+        output[i] = S1ChordAngle(points.point(i), other.point(i)) <= S1ChordAngle::Radians(distance[i]);
+      }
+    }
+  }
+
+  return output;
+}
+
 // [[Rcpp::export]]
 LogicalVector cpp_s2_prepared_dwithin(List geog1, List geog2, NumericVector distance) {
   if (distance.size() != geog1.size())  {
@@ -135,7 +204,7 @@ LogicalVector cpp_s2_prepared_dwithin(List geog1, List geog2, NumericVector dist
     std::vector<S2CellId> covering;
     RGeography* covering_id;
     std::unique_ptr<S2ClosestEdgeQuery> query;
-    MutableS2ShapeIndex::Iterator iterator;
+    S2ShapeIndex::Iterator iterator;
 
     Op(NumericVector distance):
       distance(distance), covering_id(nullptr) {}
@@ -190,7 +259,8 @@ LogicalVector cpp_s2_intersects_box(List geog,
     Op(NumericVector lng1, NumericVector lat1,
        NumericVector lng2, NumericVector lat2,
        IntegerVector detail, List s2options):
-      lng1(lng1), lat1(lat1), lng2(lng2), lat2(lat2), detail(detail) {
+      lng1(lng1), lat1(lat1), lng2(lng2), lat2(lat2), detail(detail),
+      last_box(-1) {
 
       GeographyOperationOptions options(s2options);
       this->options = options.booleanOperationOptions();
@@ -209,6 +279,34 @@ LogicalVector cpp_s2_intersects_box(List geog,
         stop("Can't create polygon from bounding box with detail < 1");
       }
 
+      // the box is usually recycled, so it is only prepared again if it
+      // differs from the box used for the previous feature
+      if (last_box < 0 ||
+          xmin != this->lng1[last_box] || ymin != this->lat1[last_box] ||
+          xmax != this->lng2[last_box] || ymax != this->lat2[last_box] ||
+          detail != this->detail[last_box]) {
+        prepareBox(xmin, ymin, xmax, ymax, detail);
+        last_box = i;
+      }
+
+      // a box with no width or height doesn't intersect anything
+      if (!box) {
+        return false;
+      }
+
+      int intersects = box->IntersectsBound(feature->RectBound());
+      if (intersects != -1) {
+        return intersects;
+      }
+
+      return box->Intersects(feature->Index(), options);
+    }
+
+  private:
+    R_xlen_t last_box;
+    std::unique_ptr<s2geography::PreparedBox> box;
+
+    void prepareBox(double xmin, double ymin, double xmax, double ymax, int detail) {
       // can't just do xmax - xmin because these boxes can wrap around the date line
       S2Point westEquator = S2LatLng::FromDegrees(0, xmin).Normalized().ToPoint();
       S2Point eastEquator = S2LatLng::FromDegrees(0, xmax).Normalized().ToPoint();
@@ -220,12 +318,12 @@ LogicalVector cpp_s2_intersects_box(List geog,
       // these situations would result in an error below because of
       // duplicate vertices
       if (widthDegrees == 0 || heightDegrees == 0) {
-        return false;
+        box.reset();
+        return;
       }
 
       S2LatLngRect rect(S2LatLng::FromDegrees(ymin, xmin), S2LatLng::FromDegrees(ymax, xmax));
-
-      return s2geography::s2_intersects_box(feature->Index(), rect, options, deltaDegrees);
+      box = absl::make_unique<s2geography::PreparedBox>(rect, deltaDegrees);
     }
   };
 
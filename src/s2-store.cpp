@@ -0,0 +1,246 @@
+
+// windows.h must be included before R's headers
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstdio>
+#include <cstring>
+
+#include "s2/util/coding/coder.h"
+
+#include "geography.h"
+
+#include <Rcpp.h>
+using namespace Rcpp;
+
+// A geography store is a single file containing one encoded shape index
+// (see s2geography::util::EncodeShapeIndex()) per feature. The layout is:
+//
+// - an 8-byte magic string ("S2GSTORE")
+// - the format version as a native-endian uint32 (used to detect
+//   files written on a platform with a different byte order)
+// - 4 bytes of padding
+// - the number of features (n) as a uint64
+// - n + 1 uint64 offsets (from the start of the file) of each feature
+// - the encoded features
+//
+// Missing features are encoded as zero bytes. Because the file is memory
+// mapped and features are decoded lazily, opening a store is cheap and
+// only the pages belonging to features that are used are read from disk.
+
+static const char kStoreMagic[] = "S2GSTORE";
+static const uint32_t kStoreVersion = 1;
+static const size_t kStoreHeaderSize = 24;
+
+class MappedFile {
+public:
+  MappedFile(const std::string& path): data_(nullptr), size_(0) {
+#ifdef _WIN32
+    file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE) {
+      throw std::runtime_error("Can't open geography store '" + path + "'");
+    }
+
+    LARGE_INTEGER size;
+    GetFileSizeEx(file_, &size);
+    size_ = size.QuadPart;
+
+    mapping_ = nullptr;
+    if (size_ > 0) {
+      mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if (mapping_ != nullptr) {
+        data_ = reinterpret_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+      }
+
+      if (data_ == nullptr) {
+        if (mapping_ != nullptr) CloseHandle(mapping_);
+        CloseHandle(file_);
+        throw std::runtime_error("Can't memory map geography store '" + path + "'");
+      }
+    }
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+      throw std::runtime_error("Can't open geography store '" + path + "'");
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+      close(fd);
+      throw std::runtime_error("Can't stat geography store '" + path + "'");
+    }
+    size_ = st.st_size;
+
+    if (size_ > 0) {
+      void* data = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+      if (data == MAP_FAILED) {
+        close(fd);
+        throw std::runtime_error("Can't memory map geography store '" + path + "'");
+      }
+      data_ = reinterpret_cast<const char*>(data);
+    }
+
+    // the mapping remains valid after the file descriptor is closed
+    close(fd);
+#endif
+  }
+
+  ~MappedFile() {
+#ifdef _WIN32
+    if (data_ != nullptr) {
+      UnmapViewOfFile(data_);
+      CloseHandle(mapping_);
+    }
+    CloseHandle(file_);
+#else
+    if (data_ != nullptr) {
+      munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+  }
+
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+
+private:
+  const char* data_;
+  size_t size_;
+#ifdef _WIN32
+  HANDLE file_;
+  HANDLE mapping_;
+#endif
+};
+
+// Features of an open store share (and keep alive) the mapping
+class StoredGeography: public s2geography::EncodedShapeIndexGeography {
+public:
+  StoredGeography(std::shared_ptr<MappedFile> file, uint64_t offset, uint64_t size):
+    file_(file) {
+    Init(file_->data() + offset, size);
+  }
+
+private:
+  std::shared_ptr<MappedFile> file_;
+};
+
+static bool store_replace_file(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+  return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+  return rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+// The store is written to a temporary file in the same directory that
+// replaces path only after it has been written completely. This leaves an
+// existing file intact if writing fails and means that geog may contain
+// features of the store being overwritten (which read from a mapping of the
+// original file).
+// [[Rcpp::export]]
+void cpp_s2_geography_store_write(List geog, std::string path) {
+  std::string tmp_path = path + ".tmp";
+  FILE* file = fopen(tmp_path.c_str(), "wb");
+  if (file == nullptr) {
+    stop("Can't open '%s' for writing", tmp_path);
+  }
+
+  uint64_t n = geog.size();
+  std::vector<uint64_t> offsets(n + 1);
+  uint32_t padding = 0;
+  size_t offsets_start = kStoreHeaderSize;
+
+  // write the header, skipping over the offsets until they are known
+  bool success = fwrite(kStoreMagic, 1, 8, file) == 8 &&
+    fwrite(&kStoreVersion, sizeof(uint32_t), 1, file) == 1 &&
+    fwrite(&padding, sizeof(uint32_t), 1, file) == 1 &&
+    fwrite(&n, sizeof(uint64_t), 1, file) == 1 &&
+    fwrite(offsets.data(), sizeof(uint64_t), n + 1, file) == (n + 1);
+
+  Encoder encoder;
+  offsets[0] = offsets_start + (n + 1) * sizeof(uint64_t);
+  for (uint64_t i = 0; success && i < n; i++) {
+    SEXP item = geog[i];
+    encoder.clear();
+
+    if (item != R_NilValue) {
+      Rcpp::XPtr<RGeography> feature(item);
+      try {
+        s2geography::util::EncodeShapeIndex(feature->Geog(), &encoder);
+      } catch (...) {
+        fclose(file);
+        remove(tmp_path.c_str());
+        throw;
+      }
+    }
+
+    success = fwrite(encoder.base(), 1, encoder.length(), file) == encoder.length();
+    offsets[i + 1] = offsets[i] + encoder.length();
+  }
+
+  success = success &&
+    fseek(file, offsets_start, SEEK_SET) == 0 &&
+    fwrite(offsets.data(), sizeof(uint64_t), n + 1, file) == (n + 1);
+
+  success = (fclose(file) == 0) && success && store_replace_file(tmp_path, path);
+  if (!success) {
+    remove(tmp_path.c_str());
+    stop("Error writing geography store to '%s'", path);
+  }
+}
+
+// [[Rcpp::export]]
+List cpp_s2_geography_store_open(std::string path) {
+  auto file = std::make_shared<MappedFile>(path);
+
+  const char* data = file->data();
+  if (file->size() < kStoreHeaderSize || memcmp(data, kStoreMagic, 8) != 0) {
+    stop("'%s' is not a geography store", path);
+  }
+
+  uint32_t version;
+  memcpy(&version, data + 8, sizeof(uint32_t));
+  if (version != kStoreVersion) {
+    stop("Geography store '%s' has an unsupported version or byte order", path);
+  }
+
+  uint64_t n;
+  memcpy(&n, data + 16, sizeof(uint64_t));
+  if (n >= ((file->size() - kStoreHeaderSize) / sizeof(uint64_t))) {
+    stop("Geography store '%s' is truncated", path);
+  }
+
+  std::vector<uint64_t> offsets(n + 1);
+  memcpy(offsets.data(), data + kStoreHeaderSize, (n + 1) * sizeof(uint64_t));
+
+  // features start after the offset table (otherwise the header and offsets
+  // would be decoded as a feature)
+  if (offsets[0] < kStoreHeaderSize + (n + 1) * sizeof(uint64_t)) {
+    stop("Geography store '%s' has an invalid offset table", path);
+  }
+
+  List output(n);
+  for (uint64_t i = 0; i < n; i++) {
+    if (offsets[i + 1] < offsets[i] || offsets[i + 1] > file->size()) {
+      stop("Geography store '%s' is truncated", path);
+    }
+
+    uint64_t size = offsets[i + 1] - offsets[i];
+    if (size == 0) {
+      output[i] = R_NilValue;
+    } else {
+      output[i] = RGeography::MakeXPtr(
+        absl::make_unique<StoredGeography>(file, offsets[i], size)
+      );
+    }
+  }
+
+  return output;
+}
@@ -4,6 +4,7 @@
 
 #include "s2-options.h"
 #include "geography-operator.h"
+#include "linear-reference-vector.h"
 
 #include <Rcpp.h>
 using namespace Rcpp;
@@ -153,29 +154,40 @@ List cpp_s2_rebuild_agg(List geog, List s2options, bool naRm) {
 }
 
 // [[Rcpp::export]]
-List cpp_s2_closest_point(List geog1, List geog2) {
+List cpp_s2_closest_point(List geog1, List geog2, NumericVector maxError) {
   class Op: public BinaryGeographyOperator<List, SEXP> {
+  public:
+    Op(NumericVector maxError): maxError(maxError) {}
 
     SEXP processFeature(XPtr<RGeography> feature1, XPtr<RGeography> feature2, R_xlen_t i) {
-      S2Point pt = s2geography::s2_closest_point(feature1->Index(), feature2->Index());
+      query.set_max_error(maxError[i]);
+      S2Point pt = query.ClosestPoint(feature1->Index(), feature2->Index());
       if (pt.Norm2() == 0) {
         return RGeography::MakeXPtr(RGeography::MakePoint());
       } else {
         return RGeography::MakeXPtr(RGeography::MakePoint(pt));
       }
     }
+
+  private:
+    NumericVector maxError;
+    // reuses the queries and target if consecutive pairs share a feature
+    s2geography::PairwiseDistance query;
   };
 
-  Op op;
+  Op op(maxError);
   return op.processVector(geog1, geog2);
 }
 
 // [[Rcpp::export]]
-List cpp_s2_minimum_clearance_line_between(List geog1, List geog2) {
+List cpp_s2_minimum_clearance_line_between(List geog1, List geog2, NumericVector maxError) {
   class Op: public BinaryGeographyOperator<List, SEXP> {
+  public:
+    Op(NumericVector maxError): maxError(maxError) {}
 
     SEXP processFeature(XPtr<RGeography> feature1, XPtr<RGeography> feature2, R_xlen_t i) {
-      std::pair<S2Point, S2Point> pts = s2geography::s2_minimum_clearance_line_between(
+      query.set_max_error(maxError[i]);
+      std::pair<S2Point, S2Point> pts = query.MinimumClearanceLineBetween(
         feature1->Index(),
         feature2->Index()
       );
@@ -199,9 +211,13 @@ List cpp_s2_minimum_clearance_line_between(List geog1, List geog2) {
         return RGeography::MakeXPtr(RGeography::MakePolyline(std::move(polyline)));
       }
     }
+
+  private:
+    NumericVector maxError;
+    s2geography::PairwiseDistance query;
   };
 
-  Op op;
+  Op op(maxError);
   return op.processVector(geog1, geog2);
 }
 
@@ -307,38 +323,135 @@ List cpp_s2_unary_union(List geog, List s2options) {
 }
 
 // [[Rcpp::export]]
-List cpp_s2_interpolate_normalized(List geog, NumericVector distanceNormalized) {
-  class Op: public UnaryGeographyOperator<List, SEXP> {
-  public:
-    NumericVector distanceNormalized;
-    Op(NumericVector distanceNormalized): distanceNormalized(distanceNormalized) {}
-    SEXP processFeature(XPtr<RGeography> feature, R_xlen_t i) {
-      if (NumericVector::is_na(this->distanceNormalized[i])) {
-        return R_NilValue;
+List cpp_s2_interpolate(List geog, NumericVector distance, bool normalized,
+                        int numThreads) {
+  LinearReferenceVector lines(geog, false, numThreads);
+  std::vector<std::unique_ptr<s2geography::Geography>> result(lines.size());
+  std::vector<const char*> problems(lines.size(), nullptr);
+  const double* distancePtr = REAL(distance);
+
+  s2_parallel_for(lines.size(), numThreads, [&](int threadId, int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      const s2geography::Geography* feature = lines.feature(i);
+      if (feature == nullptr || ISNAN(distancePtr[i])) {
+        continue;
       }
 
-      if (s2geography::s2_is_empty(feature->Geog())) {
-        return RGeography::MakeXPtr(RGeography::MakePoint());
+      if (s2geography::s2_is_empty(*feature)) {
+        result[i] = absl::make_unique<s2geography::PointGeography>();
+        continue;
       }
 
-      if (s2geography::s2_is_collection(feature->Geog())) {
-        throw GeographyOperatorException("`x` must be a simple geography");
-      } else if (feature->Geog().dimension() != 1) {
-        throw GeographyOperatorException("`x` must be a polyline");
+      if (s2geography::s2_is_collection(*feature)) {
+        problems[i] = "`x` must be a simple geography";
+        continue;
+      } else if (feature->dimension() != 1 || lines.reference(i) == nullptr) {
+        problems[i] = "`x` must be a polyline";
+        continue;
       }
 
-      S2Point point = s2geography::s2_interpolate_normalized(feature->Geog(), this->distanceNormalized[i]);
+      const s2geography::LinearReference* reference = lines.reference(i);
+      double distanceNormalized = distancePtr[i];
+      if (!normalized) {
+        distanceNormalized /= reference->length();
+      }
 
+      // e.g., a distance along a line with zero length
+      if (ISNAN(distanceNormalized)) {
+        continue;
+      }
+
+      S2Point point = reference->Interpolate(distanceNormalized);
       if (point.Norm2() == 0) {
-        return RGeography::MakeXPtr(RGeography::MakePoint());
+        result[i] = absl::make_unique<s2geography::PointGeography>();
       } else {
-        return RGeography::MakeXPtr(RGeography::MakePoint(point));
+        result[i] = absl::make_unique<s2geography::PointGeography>(point);
       }
     }
-  };
+  });
 
-  Op op(distanceNormalized);
-  return op.processVector(geog);
+  LinearReferenceVector::stopProblems(problems);
+
+  List output(lines.size());
+  for (R_xlen_t i = 0; i < lines.size(); i++) {
+    if (result[i]) {
+      output[i] = RGeography::MakeXPtr(std::move(result[i]));
+    } else {
+      output[i] = R_NilValue;
+    }
+  }
+
+  return output;
+}
+
+// [[Rcpp::export]]
+List cpp_s2_substring(List geog, NumericVector start, NumericVector end,
+                      bool normalized, int numThreads) {
+  LinearReferenceVector lines(geog, false, numThreads);
+  std::vector<std::unique_ptr<s2geography::Geography>> result(lines.size());
+  std::vector<const char*> problems(lines.size(), nullptr);
+  const double* startPtr = REAL(start);
+  const double* endPtr = REAL(end);
+
+  s2_parallel_for(lines.size(), numThreads, [&](int threadId, int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      const s2geography::Geography* feature = lines.feature(i);
+      if (feature == nullptr || ISNAN(startPtr[i]) || ISNAN(endPtr[i])) {
+        continue;
+      }
+
+      if (s2geography::s2_is_empty(*feature)) {
+        result[i] = absl::make_unique<s2geography::PolylineGeography>();
+        continue;
+      }
+
+      if (s2geography::s2_is_collection(*feature)) {
+        problems[i] = "`x` must be a simple geography";
+        continue;
+      } else if (feature->dimension() != 1 || lines.reference(i) == nullptr) {
+        problems[i] = "`x` must be a polyline";
+        continue;
+      } else if (startPtr[i] > endPtr[i]) {
+        problems[i] = "`start` must be less than or equal to `end`";
+        continue;
+      }
+
+      const s2geography::LinearReference* reference = lines.reference(i);
+      double startNormalized = startPtr[i];
+      double endNormalized = endPtr[i];
+      if (!normalized) {
+        startNormalized /= reference->length();
+        endNormalized /= reference->length();
+      }
+
+      if (ISNAN(startNormalized) || ISNAN(endNormalized)) {
+        continue;
+      }
+
+      std::vector<S2Point> vertices = reference->Substring(startNormalized, endNormalized);
+      if (vertices.size() == 1) {
+        result[i] = absl::make_unique<s2geography::PointGeography>(vertices[0]);
+      } else {
+        auto polyline = absl::make_unique<S2Polyline>();
+        polyline->set_s2debug_override(S2Debug::DISABLE);
+        polyline->Init(vertices);
+        result[i] = absl::make_unique<s2geography::PolylineGeography>(std::move(polyline));
+      }
+    }
+  });
+
+  LinearReferenceVector::stopProblems(problems);
+
+  List output(lines.size());
+  for (R_xlen_t i = 0; i < lines.size(); i++) {
+    if (result[i]) {
+      output[i] = RGeography::MakeXPtr(std::move(result[i]));
+    } else {
+      output[i] = R_NilValue;
+    }
+  }
+
+  return output;
 }
 
 // [[Rcpp::export]]
@@ -410,3 +523,48 @@ List cpp_s2_convex_hull_agg(List geog, bool naRm) {
 
   return List::create(RGeography::MakeXPtr(agg.Finalize()));
 }
+
+// [[Rcpp::export]]
+List cpp_s2_medoid_polyline_agg(List geog, int method, bool naRm) {
+  s2geography::MedoidPolylineAggregator agg(static_cast<s2geography::AlignmentMethod>(method));
+
+  SEXP item;
+  for (R_xlen_t i = 0; i < geog.size(); i++) {
+    item = geog[i];
+    if (item == R_NilValue && !naRm) {
+      return List::create(R_NilValue);
+    }
+
+    if (item != R_NilValue) {
+      XPtr<RGeography> feature(item);
+      agg.Add(feature->Geog());
+    }
+  }
+
+  return List::create(RGeography::MakeXPtr(agg.Finalize()));
+}
+
+// [[Rcpp::export]]
+List cpp_s2_consensus_polyline_agg(List geog, int method, bool seedMedoid,
+                                   int iterationCap, bool naRm) {
+  s2geography::ConsensusPolylineAggregator agg(
+    static_cast<s2geography::AlignmentMethod>(method),
+    seedMedoid,
+    iterationCap
+  );
+
+  SEXP item;
+  for (R_xlen_t i = 0; i < geog.size(); i++) {
+    item = geog[i];
+    if (item == R_NilValue && !naRm) {
+      return List::create(R_NilValue);
+    }
+
+    if (item != R_NilValue) {
+      XPtr<RGeography> feature(item);
+      agg.Add(feature->Geog());
+    }
+  }
+
+  return List::create(RGeography::MakeXPtr(agg.Finalize()));
+}
@@ -3,11 +3,15 @@
 
 #include "s2geography/accessors-geog.h"
 #include "s2geography/accessors.h"
+#include "s2geography/alignment.h"
 #include "s2geography/build.h"
+#include "s2geography/coding.h"
 #include "s2geography/constructor.h"
 #include "s2geography/coverings.h"
 #include "s2geography/distance.h"
+#include "s2geography/geoarrow.h"
 #include "s2geography/geography.h"
 #include "s2geography/index.h"
 #include "s2geography/linear-referencing.h"
 #include "s2geography/predicates.h"
+#include "s2geography/wkb.h"
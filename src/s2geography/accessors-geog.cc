@@ -14,7 +14,7 @@ S2Point s2_centroid(const Geography& geog) {
 
   if (geog.dimension() == 0) {
     for (int i = 0; i < geog.num_shapes(); i++) {
-      auto shape = geog.Shape(i);
+      const S2Shape* shape = geog.ShapeView(i);
       for (int j = 0; j < shape->num_edges(); j++) {
         centroid += shape->edge(j).v0;
       }
@@ -25,7 +25,7 @@ S2Point s2_centroid(const Geography& geog) {
 
   if (geog.dimension() == 1) {
     for (int i = 0; i < geog.num_shapes(); i++) {
-      auto shape = geog.Shape(i);
+      const S2Shape* shape = geog.ShapeView(i);
       for (int j = 0; j < shape->num_edges(); j++) {
         S2Shape::Edge e = shape->edge(j);
         centroid += S2::TrueCentroid(e.v0, e.v1);
@@ -36,7 +36,7 @@ S2Point s2_centroid(const Geography& geog) {
   }
 
   if (geog.dimension() == 2) {
-    auto polygon_ptr = dynamic_cast<const PolygonGeography*>(&geog);
+    auto polygon_ptr = geography_cast<PolygonGeography>(&geog);
     if (polygon_ptr != nullptr) {
       centroid = polygon_ptr->Polygon()->GetCentroid();
     } else {
@@ -47,7 +47,7 @@ S2Point s2_centroid(const Geography& geog) {
     return centroid.Normalize();
   }
 
-  auto collection_ptr = dynamic_cast<const GeographyCollection*>(&geog);
+  auto collection_ptr = geography_cast<GeographyCollection>(&geog);
   if (collection_ptr == nullptr) {
     throw Exception(
         "Can't compute s2_centroid() on custom collection geography");
@@ -66,7 +66,7 @@ std::unique_ptr<Geography> s2_boundary(const Geography& geog) {
   if (dimension == 1) {
     std::vector<S2Point> endpoints;
     for (int i = 0; i < geog.num_shapes(); i++) {
-      auto shape = geog.Shape(i);
+      const S2Shape* shape = geog.ShapeView(i);
       if (shape->dimension() < 1) {
         continue;
       }
@@ -89,7 +89,7 @@ std::unique_ptr<Geography> s2_boundary(const Geography& geog) {
     polylines.reserve(geog.num_shapes());
 
     for (int i = 0; i < geog.num_shapes(); i++) {
-      auto shape = geog.Shape(i);
+      const S2Shape* shape = geog.ShapeView(i);
       if (shape->dimension() != 2) {
         throw Exception("Can't extract boundary from heterogeneous collection");
       }
@@ -143,7 +143,7 @@ S2Point CentroidAggregator::Finalize() {
 
 void S2ConvexHullAggregator::Add(const Geography& geog) {
   if (geog.dimension() == 0) {
-    auto point_ptr = dynamic_cast<const PointGeography*>(&geog);
+    auto point_ptr = geography_cast<PointGeography>(&geog);
     if (point_ptr != nullptr) {
       for (const auto& point : point_ptr->Points()) {
         query_.AddPoint(point);
@@ -157,7 +157,7 @@ void S2ConvexHullAggregator::Add(const Geography& geog) {
   }
 
   if (geog.dimension() == 1) {
-    auto poly_ptr = dynamic_cast<const PolylineGeography*>(&geog);
+    auto poly_ptr = geography_cast<PolylineGeography>(&geog);
     if (poly_ptr != nullptr) {
       for (const auto& polyline : poly_ptr->Polylines()) {
         query_.AddPolyline(*polyline);
@@ -171,7 +171,7 @@ void S2ConvexHullAggregator::Add(const Geography& geog) {
   }
 
   if (geog.dimension() == 2) {
-    auto poly_ptr = dynamic_cast<const PolygonGeography*>(&geog);
+    auto poly_ptr = geography_cast<PolygonGeography>(&geog);
     if (poly_ptr != nullptr) {
       query_.AddPolygon(*poly_ptr->Polygon());
     } else {
@@ -182,7 +182,7 @@ void S2ConvexHullAggregator::Add(const Geography& geog) {
     return;
   }
 
-  auto collection_ptr = dynamic_cast<const GeographyCollection*>(&geog);
+  auto collection_ptr = geography_cast<GeographyCollection>(&geog);
   if (collection_ptr != nullptr) {
     for (const auto& feature : collection_ptr->Features()) {
       Add(*feature);
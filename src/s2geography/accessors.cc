@@ -1,6 +1,8 @@
 
 #include "accessors.h"
 
+#include <s2/s2shape_measures.h>
+
 #include "build.h"
 #include "geography.h"
 
@@ -33,7 +35,7 @@ bool s2_is_collection(const Geography& geog) {
   if (dimension == 1) {
     int num_chains = 0;
     for (int i = 0; i < geog.num_shapes(); i++) {
-      std::unique_ptr<S2Shape> shape = geog.Shape(i);
+      const S2Shape* shape = geog.ShapeView(i);
       num_chains += shape->num_chains();
       if (num_chains > 1) {
         return true;
@@ -43,7 +45,7 @@ bool s2_is_collection(const Geography& geog) {
     return false;
   }
 
-  auto polygon_geog_ptr = dynamic_cast<const PolygonGeography*>(&geog);
+  auto polygon_geog_ptr = geography_cast<PolygonGeography>(&geog);
   if (polygon_geog_ptr != nullptr) {
     return s2_is_collection(*polygon_geog_ptr);
   } else {
@@ -59,7 +61,7 @@ int s2_dimension(const Geography& geog) {
   }
 
   for (int i = 0; i < geog.num_shapes(); i++) {
-    std::unique_ptr<S2Shape> shape = geog.Shape(i);
+    const S2Shape* shape = geog.ShapeView(i);
     if (shape->dimension() > dimension) {
       dimension = shape->dimension();
     }
@@ -71,7 +73,7 @@ int s2_dimension(const Geography& geog) {
 int s2_num_points(const Geography& geog) {
   int num_points = 0;
   for (int i = 0; i < geog.num_shapes(); i++) {
-    std::unique_ptr<S2Shape> shape = geog.Shape(i);
+    const S2Shape* shape = geog.ShapeView(i);
     switch (shape->dimension()) {
       case 0:
       case 2:
@@ -88,7 +90,7 @@ int s2_num_points(const Geography& geog) {
 
 bool s2_is_empty(const Geography& geog) {
   for (int i = 0; i < geog.num_shapes(); i++) {
-    std::unique_ptr<S2Shape> shape = geog.Shape(i);
+    const S2Shape* shape = geog.ShapeView(i);
     if (!shape->is_empty()) {
       return false;
     }
@@ -114,16 +116,29 @@ double s2_area(const Geography& geog) {
     return 0;
   }
 
-  auto polygon_geog_ptr = dynamic_cast<const PolygonGeography*>(&geog);
+  auto polygon_geog_ptr = geography_cast<PolygonGeography>(&geog);
   if (polygon_geog_ptr != nullptr) {
     return s2_area(*polygon_geog_ptr);
   }
 
-  auto collection_geog_ptr = dynamic_cast<const GeographyCollection*>(&geog);
+  auto collection_geog_ptr = geography_cast<GeographyCollection>(&geog);
   if (collection_geog_ptr != nullptr) {
     return s2_area(*collection_geog_ptr);
   }
 
+  // Other subclasses (e.g., EncodedShapeIndexGeography) can mix dimensions
+  // like a collection, in which case the area of each polygon is summed
+  if (geog.dimension() == -1) {
+    double area = 0;
+    for (int i = 0; i < geog.num_shapes(); i++) {
+      const S2Shape* shape = geog.ShapeView(i);
+      if (shape->dimension() == 2) {
+        area += S2::GetArea(*shape);
+      }
+    }
+    return area;
+  }
+
   std::unique_ptr<PolygonGeography> built = s2_build_polygon(geog);
   return s2_area(*built);
 }
@@ -133,7 +148,7 @@ double s2_length(const Geography& geog) {
 
   if (s2_dimension(geog) == 1) {
     for (int i = 0; i < geog.num_shapes(); i++) {
-      std::unique_ptr<S2Shape> shape = geog.Shape(i);
+      const S2Shape* shape = geog.ShapeView(i);
       for (int j = 0; j < shape->num_edges(); j++) {
         S2Shape::Edge e = shape->edge(j);
         S1ChordAngle angle(e.v0, e.v1);
@@ -150,7 +165,7 @@ double s2_perimeter(const Geography& geog) {
 
   if (s2_dimension(geog) == 2) {
     for (int i = 0; i < geog.num_shapes(); i++) {
-      std::unique_ptr<S2Shape> shape = geog.Shape(i);
+      const S2Shape* shape = geog.ShapeView(i);
       for (int j = 0; j < shape->num_edges(); j++) {
         S2Shape::Edge e = shape->edge(j);
         S1ChordAngle angle(e.v0, e.v1);
@@ -162,10 +177,217 @@ double s2_perimeter(const Geography& geog) {
   return length;
 }
 
+namespace {
+
+// The angle subtended by an edge, 2 * asin(c / 2) where c is its chord
+// length. For edges shorter than ~600 km, the first terms of the series
+// expansion of asin() are accurate to ~1e-9 (relative) and much cheaper.
+inline double ApproxEdgeAngle(const S2Point& a, const S2Point& b) {
+  double c2 = (a - b).Norm2();
+  double c = std::sqrt(c2);
+  if (c < 0.1) {
+    return c * (1 + c2 * (1.0 / 24 + c2 * (3.0 / 640)));
+  } else {
+    return 2 * std::asin(std::min(1.0, 0.5 * c));
+  }
+}
+
+double ApproxChainLength(const S2Point* v, int n) {
+  double length = 0;
+  for (int i = 1; i < n; i++) {
+    length += ApproxEdgeAngle(v[i - 1], v[i]);
+  }
+  return length;
+}
+
+double ApproxLoopLength(const S2Point* v, int n) {
+  if (n < 2) {
+    return 0;
+  }
+
+  return ApproxChainLength(v, n) + ApproxEdgeAngle(v[n - 1], v[0]);
+}
+
+// The signed area of a loop (in the range -2 * pi to 2 * pi) as the sum of
+// the spherical excess of triangles (v[0], v[i], v[i + 1]) using Eriksson's
+// formula. The triple product is computed relative to v[0], which is much
+// more accurate for small triangles than det(v[0], v[i], v[i + 1]).
+double ApproxSignedLoopArea(const S2Point* v, int n) {
+  double excess = 0;
+  for (int i = 1; i + 1 < n; i++) {
+    S2Point ab = v[i] - v[0];
+    S2Point ac = v[i + 1] - v[0];
+    double det = v[0].DotProd(ab.CrossProd(ac));
+    double denom =
+        1 + v[0].DotProd(v[i]) + v[i].DotProd(v[i + 1]) + v[i + 1].DotProd(v[0]);
+    excess += 2 * std::atan2(det, denom);
+  }
+
+  return excess;
+}
+
+double ApproxLoopArea(const S2Loop& loop) {
+  if (loop.is_empty_or_full()) {
+    return loop.GetArea();
+  }
+
+  S2PointLoopSpan vertices = loop.vertices_span();
+  double area = ApproxSignedLoopArea(vertices.data(), vertices.size());
+
+  // Loops are oriented so that the area is at most 4 * pi; however, when
+  // the area is very close to 0 or 4 * pi the sign can't be trusted
+  static const double kMaxAmbiguousArea = 1e-12;
+  if (std::abs(area) < kMaxAmbiguousArea) {
+    return loop.GetArea();
+  } else if (area < 0) {
+    return area + 4 * M_PI;
+  } else {
+    return area;
+  }
+}
+
+double ApproxShapeLength(const S2Shape& shape) {
+  double length = 0;
+  for (int j = 0; j < shape.num_edges(); j++) {
+    S2Shape::Edge e = shape.edge(j);
+    length += ApproxEdgeAngle(e.v0, e.v1);
+  }
+  return length;
+}
+
+double ApproxShapeArea(const S2Shape& shape, std::vector<S2Point>* scratch) {
+  double area = 0;
+  for (int i = 0; i < shape.num_chains(); i++) {
+    S2Shape::Chain chain = shape.chain(i);
+    scratch->clear();
+    for (int j = 0; j < chain.length; j++) {
+      scratch->push_back(shape.chain_edge(i, j).v0);
+    }
+    area += ApproxSignedLoopArea(scratch->data(), scratch->size());
+  }
+
+  // as for loops, the sign of (e.g.) a full polygon is ambiguous
+  static const double kMaxAmbiguousArea = 1e-12;
+  if (std::abs(area) < kMaxAmbiguousArea) {
+    return S2::GetArea(shape);
+  } else if (area < 0) {
+    return area + 4 * M_PI;
+  } else {
+    return area;
+  }
+}
+
+double ApproxLength(const Geography& geog) {
+  double length = 0;
+
+  switch (geog.kind()) {
+    case GeographyKind::POINT:
+      break;
+
+    case GeographyKind::POLYLINE:
+      for (const auto& polyline :
+           static_cast<const PolylineGeography&>(geog).Polylines()) {
+        S2PointSpan vertices = polyline->vertices_span();
+        length += ApproxChainLength(vertices.data(), vertices.size());
+      }
+      break;
+
+    case GeographyKind::POLYGON: {
+      const S2Polygon& polygon =
+          *static_cast<const PolygonGeography&>(geog).Polygon();
+      for (int i = 0; i < polygon.num_loops(); i++) {
+        const S2Loop& loop = *polygon.loop(i);
+        if (!loop.is_empty_or_full()) {
+          S2PointLoopSpan vertices = loop.vertices_span();
+          length += ApproxLoopLength(vertices.data(), vertices.size());
+        }
+      }
+      break;
+    }
+
+    case GeographyKind::GEOGRAPHY_COLLECTION:
+      for (const auto& feature :
+           static_cast<const GeographyCollection&>(geog).Features()) {
+        length += ApproxLength(*feature);
+      }
+      break;
+
+    default:
+      for (int i = 0; i < geog.num_shapes(); i++) {
+        length += ApproxShapeLength(*geog.ShapeView(i));
+      }
+      break;
+  }
+
+  return length;
+}
+
+double ApproxArea(const Geography& geog) {
+  double area = 0;
+
+  switch (geog.kind()) {
+    case GeographyKind::POLYGON: {
+      const S2Polygon& polygon =
+          *static_cast<const PolygonGeography&>(geog).Polygon();
+      for (int i = 0; i < polygon.num_loops(); i++) {
+        const S2Loop& loop = *polygon.loop(i);
+        area += loop.sign() * ApproxLoopArea(loop);
+      }
+      break;
+    }
+
+    case GeographyKind::GEOGRAPHY_COLLECTION:
+      for (const auto& feature :
+           static_cast<const GeographyCollection&>(geog).Features()) {
+        area += ApproxArea(*feature);
+      }
+      break;
+
+    default: {
+      std::vector<S2Point> scratch;
+      for (int i = 0; i < geog.num_shapes(); i++) {
+        const S2Shape* shape = geog.ShapeView(i);
+        if (shape->dimension() == 2) {
+          area += ApproxShapeArea(*shape, &scratch);
+        }
+      }
+      break;
+    }
+  }
+
+  return area;
+}
+
+}  // namespace
+
+double s2_area_approx(const Geography& geog) {
+  if (s2_dimension(geog) != 2) {
+    return 0;
+  }
+
+  return ApproxArea(geog);
+}
+
+double s2_length_approx(const Geography& geog) {
+  if (s2_dimension(geog) != 1) {
+    return 0;
+  }
+
+  return ApproxLength(geog);
+}
+
+double s2_perimeter_approx(const Geography& geog) {
+  if (s2_dimension(geog) != 2) {
+    return 0;
+  }
+
+  return ApproxLength(geog);
+}
+
 double s2_x(const Geography& geog) {
   double out = NAN;
   for (int i = 0; i < geog.num_shapes(); i++) {
-    std::unique_ptr<S2Shape> shape = geog.Shape(i);
+    const S2Shape* shape = geog.ShapeView(i);
     if (shape->dimension() == 0 && shape->num_edges() == 1 && std::isnan(out)) {
       S2LatLng pt(shape->edge(0).v0);
       out = pt.lng().degrees();
@@ -180,7 +402,7 @@ double s2_x(const Geography& geog) {
 double s2_y(const Geography& geog) {
   double out = NAN;
   for (int i = 0; i < geog.num_shapes(); i++) {
-    std::unique_ptr<S2Shape> shape = geog.Shape(i);
+    const S2Shape* shape = geog.ShapeView(i);
     if (shape->dimension() == 0 && shape->num_edges() == 1 && std::isnan(out)) {
       S2LatLng pt(shape->edge(0).v0);
       out = pt.lat().degrees();
@@ -224,7 +446,7 @@ bool s2_find_validation_error(const Geography& geog, S2Error* error) {
   }
 
   if (geog.dimension() == 1) {
-    auto poly_ptr = dynamic_cast<const PolylineGeography*>(&geog);
+    auto poly_ptr = geography_cast<PolylineGeography>(&geog);
     if (poly_ptr != nullptr) {
       return s2_find_validation_error(*poly_ptr, error);
     } else {
@@ -239,7 +461,7 @@ bool s2_find_validation_error(const Geography& geog, S2Error* error) {
   }
 
   if (geog.dimension() == 2) {
-    auto poly_ptr = dynamic_cast<const PolygonGeography*>(&geog);
+    auto poly_ptr = geography_cast<PolygonGeography>(&geog);
     if (poly_ptr != nullptr) {
       return s2_find_validation_error(*poly_ptr, error);
     } else {
@@ -253,7 +475,7 @@ bool s2_find_validation_error(const Geography& geog, S2Error* error) {
     }
   }
 
-  auto collection_ptr = dynamic_cast<const GeographyCollection*>(&geog);
+  auto collection_ptr = geography_cast<GeographyCollection>(&geog);
   if (collection_ptr != nullptr) {
     return s2_find_validation_error(*collection_ptr, error);
   } else {
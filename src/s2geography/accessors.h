@@ -12,6 +12,18 @@ bool s2_is_empty(const Geography& geog);
 double s2_area(const Geography& geog);
 double s2_length(const Geography& geog);
 double s2_perimeter(const Geography& geog);
+
+// Faster versions of s2_area(), s2_length(), and s2_perimeter() that trade
+// a small amount of accuracy for speed. Vertices of polygons and polylines
+// are read directly from the underlying S2Loop/S2Polyline vertex arrays,
+// edge lengths are computed from chord lengths using a series expansion,
+// and areas are computed from the spherical excess of a fan of triangles
+// rather than using S2's (more robust) surface integral. Results agree with
+// the exact versions to ~1e-9 (relative) for all but degenerate loops.
+// Unlike s2_area(), s2_area_approx() never rebuilds its input.
+double s2_area_approx(const Geography& geog);
+double s2_length_approx(const Geography& geog);
+double s2_perimeter_approx(const Geography& geog);
 double s2_x(const Geography& geog);
 double s2_y(const Geography& geog);
 bool s2_find_validation_error(const Geography& geog, S2Error* error);
@@ -0,0 +1,87 @@
+
+#include "alignment.h"
+
+#include <s2/s2polyline_alignment.h>
+
+#include "accessors.h"
+#include "linear-referencing.h"
+
+namespace s2geography {
+
+// Exact alignments whose table has more cells than this (e.g., two traces
+// with more than 1000 vertices each) use the approximate algorithm by
+// default
+static const int64_t kMaxExactAlignmentCells = 1000000;
+
+static bool UseApproxAlignment(AlignmentMethod method, int64_t max_cells) {
+  switch (method) {
+    case AlignmentMethod::kExact:
+      return false;
+    case AlignmentMethod::kApprox:
+      return true;
+    default:
+      return max_cells > kMaxExactAlignmentCells;
+  }
+}
+
+double s2_alignment_cost(const S2Polyline& a, const S2Polyline& b,
+                         AlignmentMethod method) {
+  if (a.num_vertices() == 0 || b.num_vertices() == 0) {
+    throw Exception("Can't align an empty polyline");
+  }
+
+  int64_t cells = static_cast<int64_t>(a.num_vertices()) * b.num_vertices();
+  if (UseApproxAlignment(method, cells)) {
+    return s2polyline_alignment::GetApproxVertexAlignment(a, b).alignment_cost;
+  } else {
+    return s2polyline_alignment::GetExactVertexAlignmentCost(a, b);
+  }
+}
+
+void MedoidPolylineAggregator::Add(const Geography& geog) {
+  if (s2_is_empty(geog)) {
+    return;
+  }
+
+  LinearReference reference;
+  if (!reference.Init(geog) || reference.is_empty()) {
+    throw Exception("Can't align a geography that is not a single polyline");
+  }
+
+  polylines_.emplace_back(reference.polyline().Clone());
+}
+
+bool MedoidPolylineAggregator::UseApprox() const {
+  int64_t max_vertices = 0;
+  for (const auto& polyline : polylines_) {
+    max_vertices = std::max<int64_t>(max_vertices, polyline->num_vertices());
+  }
+
+  return UseApproxAlignment(method_, max_vertices * max_vertices);
+}
+
+std::unique_ptr<PolylineGeography> MedoidPolylineAggregator::Finalize() {
+  if (polylines_.empty()) {
+    return absl::make_unique<PolylineGeography>();
+  }
+
+  s2polyline_alignment::MedoidOptions options;
+  options.set_approx(UseApprox());
+  int medoid = s2polyline_alignment::GetMedoidPolyline(polylines_, options);
+  return absl::make_unique<PolylineGeography>(std::move(polylines_[medoid]));
+}
+
+std::unique_ptr<PolylineGeography> ConsensusPolylineAggregator::Finalize() {
+  if (polylines_.empty()) {
+    return absl::make_unique<PolylineGeography>();
+  }
+
+  s2polyline_alignment::ConsensusOptions options;
+  options.set_approx(UseApprox());
+  options.set_seed_medoid(seed_medoid_);
+  options.set_iteration_cap(iteration_cap_);
+  return absl::make_unique<PolylineGeography>(
+      s2polyline_alignment::GetConsensusPolyline(polylines_, options));
+}
+
+}  // namespace s2geography
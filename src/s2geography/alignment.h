@@ -0,0 +1,58 @@
+
+#pragma once
+
+#include <s2/s2polyline.h>
+
+#include "aggregator.h"
+#include "geography.h"
+
+namespace s2geography {
+
+// Vertex alignments are computed using dynamic timewarping. The exact
+// alignment fills a table with one cell for each pair of vertices; the
+// approximate alignment uses the multiscale FastDTW algorithm, which is
+// linear in the number of vertices. By default, the exact alignment is
+// used unless this table would be large.
+enum class AlignmentMethod { kDefault, kExact, kApprox };
+
+// The cost of the vertex alignment of two non-empty polylines (the sum of
+// the chord distances between aligned vertices)
+double s2_alignment_cost(const S2Polyline& a, const S2Polyline& b,
+                         AlignmentMethod method = AlignmentMethod::kDefault);
+
+// Collects single polylines (empty geographies are skipped) and returns the
+// input polyline with the smallest total alignment cost to all the others
+class MedoidPolylineAggregator
+    : public Aggregator<std::unique_ptr<PolylineGeography>> {
+ public:
+  MedoidPolylineAggregator(AlignmentMethod method = AlignmentMethod::kDefault)
+      : method_(method) {}
+  void Add(const Geography& geog);
+  std::unique_ptr<PolylineGeography> Finalize();
+
+ protected:
+  bool UseApprox() const;
+
+  AlignmentMethod method_;
+  std::vector<std::unique_ptr<S2Polyline>> polylines_;
+};
+
+// Collects single polylines (empty geographies are skipped) and iteratively
+// averages the aligned vertices of all of them, starting from the first
+// polyline (or the medoid if seed_medoid is true)
+class ConsensusPolylineAggregator : public MedoidPolylineAggregator {
+ public:
+  ConsensusPolylineAggregator(
+      AlignmentMethod method = AlignmentMethod::kDefault,
+      bool seed_medoid = false, int iteration_cap = 5)
+      : MedoidPolylineAggregator(method),
+        seed_medoid_(seed_medoid),
+        iteration_cap_(iteration_cap) {}
+  std::unique_ptr<PolylineGeography> Finalize();
+
+ private:
+  bool seed_medoid_;
+  int iteration_cap_;
+};
+
+}  // namespace s2geography
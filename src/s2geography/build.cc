@@ -212,7 +212,7 @@ std::unique_ptr<Geography> s2_unary_union(const ShapeIndexGeography& geog,
 
   if (geog.dimension() == 2) {
     // If we've made it here we have an invalid polygon on our hands.
-    auto poly_ptr = dynamic_cast<const PolygonGeography*>(&geog);
+    auto poly_ptr = geography_cast<PolygonGeography>(&geog);
     if (poly_ptr != nullptr) {
       return s2_unary_union(*poly_ptr, options);
     } else {
@@ -242,7 +242,7 @@ std::unique_ptr<Geography> s2_rebuild(
   builder.StartLayer(absl::make_unique<s2builderutil::S2PointVectorLayer>(
       &points, options.point_layer));
   for (int i = 0; i < geog.num_shapes(); i++) {
-    auto shape = geog.Shape(i);
+    const S2Shape* shape = geog.ShapeView(i);
     if (shape->dimension() == 0) {
       builder.AddShape(*shape);
     }
@@ -251,7 +251,7 @@ std::unique_ptr<Geography> s2_rebuild(
   builder.StartLayer(absl::make_unique<s2builderutil::S2PolylineVectorLayer>(
       &polylines, options.polyline_layer));
   for (int i = 0; i < geog.num_shapes(); i++) {
-    auto shape = geog.Shape(i);
+    const S2Shape* shape = geog.ShapeView(i);
     if (shape->dimension() == 1) {
       builder.AddShape(*shape);
     }
@@ -260,7 +260,7 @@ std::unique_ptr<Geography> s2_rebuild(
   builder.StartLayer(absl::make_unique<s2builderutil::S2PolygonLayer>(
       polygon.get(), options.polygon_layer));
   for (int i = 0; i < geog.num_shapes(); i++) {
-    auto shape = geog.Shape(i);
+    const S2Shape* shape = geog.ShapeView(i);
     if (shape->dimension() == 2) {
       builder.AddShape(*shape);
     }
@@ -294,9 +294,11 @@ std::unique_ptr<PointGeography> s2_build_point(const Geography& geog) {
 
   if (s2_is_empty(*geog_out)) {
     return absl::make_unique<PointGeography>();
-  } else {
+  } else if (geog_out->kind() == PointGeography::kKind) {
     return std::unique_ptr<PointGeography>(
-      dynamic_cast<PointGeography*>(geog_out.release()));
+        static_cast<PointGeography*>(geog_out.release()));
+  } else {
+    throw Exception("Can't build point from mixed-dimension geography");
   }
 }
 
@@ -308,9 +310,11 @@ std::unique_ptr<PolylineGeography> s2_build_polyline(const Geography& geog) {
 
   if (s2_is_empty(*geog_out)) {
     return absl::make_unique<PolylineGeography>();
-  } else {
+  } else if (geog_out->kind() == PolylineGeography::kKind) {
     return std::unique_ptr<PolylineGeography>(
-      dynamic_cast<PolylineGeography*>(geog_out.release()));
+        static_cast<PolylineGeography*>(geog_out.release()));
+  } else {
+    throw Exception("Can't build polyline from mixed-dimension geography");
   }
 }
 
@@ -322,9 +326,11 @@ std::unique_ptr<PolygonGeography> s2_build_polygon(const Geography& geog) {
 
   if (s2_is_empty(*geog_out)) {
     return absl::make_unique<PolygonGeography>();
-  } else {
+  } else if (geog_out->kind() == PolygonGeography::kKind) {
     return std::unique_ptr<PolygonGeography>(
-        dynamic_cast<PolygonGeography*>(geog_out.release()));
+        static_cast<PolygonGeography*>(geog_out.release()));
+  } else {
+    throw Exception("Can't build polygon from mixed-dimension geography");
   }
 }
 
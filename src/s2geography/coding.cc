@@ -0,0 +1,290 @@
+
+#include "coding.h"
+
+#include <s2/encoded_s2point_vector.h>
+#include <s2/mutable_s2shape_index.h>
+#include <s2/s2lax_polygon_shape.h>
+#include <s2/s2lax_polyline_shape.h>
+#include <s2/s2point_vector_shape.h>
+#include <s2/s2shapeutil_coding.h>
+#include <s2/util/coding/coder.h>
+
+#include <sstream>
+
+#include "build.h"
+
+namespace s2geography {
+
+namespace util {
+
+namespace {
+
+constexpr uint8_t kCurrentEncodingVersion = 1;
+constexpr uint8_t kFlagHasIndex = 1;
+
+enum class EncodedKind : uint8_t {
+  POINT = 1,
+  POLYLINE = 2,
+  POLYGON = 3,
+  COLLECTION = 4
+};
+
+// Other subclasses (e.g., features of a geography store) are only defined by
+// their shapes and are rebuilt as points, polylines, and/or polygons before
+// they are encoded
+bool HasNativeEncoding(const Geography& geog) {
+  switch (geog.kind()) {
+    case GeographyKind::POINT:
+    case GeographyKind::POLYLINE:
+    case GeographyKind::POLYGON:
+      return true;
+    case GeographyKind::GEOGRAPHY_COLLECTION:
+      for (const auto& feature :
+           static_cast<const GeographyCollection&>(geog).Features()) {
+        if (!HasNativeEncoding(*feature)) {
+          return false;
+        }
+      }
+      return true;
+    default:
+      return false;
+  }
+}
+
+void EncodeFeature(const Geography& geog, Encoder* encoder) {
+  encoder->Ensure(1 + Varint::kMax32);
+
+  switch (geog.kind()) {
+    case GeographyKind::POINT: {
+      const auto& point = static_cast<const PointGeography&>(geog);
+      encoder->put8(static_cast<uint8_t>(EncodedKind::POINT));
+      s2coding::EncodeS2PointVector(point.Points(),
+                                    s2coding::CodingHint::COMPACT, encoder);
+      break;
+    }
+
+    case GeographyKind::POLYLINE: {
+      const auto& polyline = static_cast<const PolylineGeography&>(geog);
+      encoder->put8(static_cast<uint8_t>(EncodedKind::POLYLINE));
+      encoder->put_varint32(polyline.Polylines().size());
+      for (const auto& item : polyline.Polylines()) {
+        item->EncodeMostCompact(encoder);
+      }
+      break;
+    }
+
+    case GeographyKind::POLYGON: {
+      const auto& polygon = static_cast<const PolygonGeography&>(geog);
+      encoder->put8(static_cast<uint8_t>(EncodedKind::POLYGON));
+      polygon.Polygon()->Encode(encoder);
+      break;
+    }
+
+    case GeographyKind::GEOGRAPHY_COLLECTION: {
+      const auto& collection = static_cast<const GeographyCollection&>(geog);
+      encoder->put8(static_cast<uint8_t>(EncodedKind::COLLECTION));
+      encoder->put_varint32(collection.Features().size());
+      for (const auto& feature : collection.Features()) {
+        EncodeFeature(*feature, encoder);
+      }
+      break;
+    }
+
+    default:
+      EncodeFeature(*s2_rebuild(geog, GlobalOptions()), encoder);
+      break;
+  }
+}
+
+void CheckDecoded(bool success, const char* what) {
+  if (!success) {
+    std::stringstream err;
+    err << "Failed to decode " << what;
+    throw Exception(err.str());
+  }
+}
+
+std::unique_ptr<Geography> DecodeFeature(Decoder* decoder) {
+  CheckDecoded(decoder->avail() >= 1, "geography type");
+  uint8_t kind = decoder->get8();
+
+  switch (static_cast<EncodedKind>(kind)) {
+    case EncodedKind::POINT: {
+      s2coding::EncodedS2PointVector points;
+      CheckDecoded(points.Init(decoder), "point vector");
+      return absl::make_unique<PointGeography>(points.Decode());
+    }
+
+    case EncodedKind::POLYLINE: {
+      uint32_t n;
+      CheckDecoded(decoder->get_varint32(&n), "number of polylines");
+      std::vector<std::unique_ptr<S2Polyline>> polylines;
+      polylines.reserve(n);
+      for (uint32_t i = 0; i < n; i++) {
+        auto polyline = absl::make_unique<S2Polyline>();
+        polyline->set_s2debug_override(S2Debug::DISABLE);
+        CheckDecoded(polyline->Decode(decoder), "polyline");
+        polylines.push_back(std::move(polyline));
+      }
+      return absl::make_unique<PolylineGeography>(std::move(polylines));
+    }
+
+    case EncodedKind::POLYGON: {
+      auto polygon = absl::make_unique<S2Polygon>();
+      polygon->set_s2debug_override(S2Debug::DISABLE);
+      CheckDecoded(polygon->Decode(decoder), "polygon");
+      return absl::make_unique<PolygonGeography>(std::move(polygon));
+    }
+
+    case EncodedKind::COLLECTION: {
+      uint32_t n;
+      CheckDecoded(decoder->get_varint32(&n), "number of features");
+      std::vector<std::unique_ptr<Geography>> features;
+      features.reserve(n);
+      for (uint32_t i = 0; i < n; i++) {
+        features.push_back(DecodeFeature(decoder));
+      }
+      return absl::make_unique<GeographyCollection>(std::move(features));
+    }
+
+    default: {
+      std::stringstream err;
+      err << "Unknown encoded geography type: " << static_cast<int>(kind);
+      throw Exception(err.str());
+    }
+  }
+}
+
+// Copies the vertices of an arbitrary shape (e.g., one that was itself
+// lazily decoded) into a shape that can be lazily decoded
+void AddLaxShape(const S2Shape& shape, MutableS2ShapeIndex* index) {
+  std::vector<std::vector<S2Point>> chains(shape.num_chains());
+  for (int i = 0; i < shape.num_chains(); i++) {
+    S2Shape::Chain chain = shape.chain(i);
+    for (int j = 0; j < chain.length; j++) {
+      chains[i].push_back(shape.chain_edge(i, j).v0);
+    }
+    if (shape.dimension() == 1 && chain.length > 0) {
+      chains[i].push_back(shape.chain_edge(i, chain.length - 1).v1);
+    }
+  }
+
+  switch (shape.dimension()) {
+    case 0: {
+      std::vector<S2Point> points;
+      for (const auto& chain : chains) {
+        points.insert(points.end(), chain.begin(), chain.end());
+      }
+      index->Add(absl::make_unique<S2PointVectorShape>(std::move(points)));
+      break;
+    }
+    case 1:
+      for (const auto& chain : chains) {
+        index->Add(absl::make_unique<S2LaxPolylineShape>(chain));
+      }
+      break;
+    default:
+      index->Add(absl::make_unique<S2LaxPolygonShape>(chains));
+      break;
+  }
+}
+
+// Adds shapes to index that can be lazily decoded after they are encoded
+// (i.e., ones whose encoded form has an Encoded* counterpart)
+void AddLaxShapes(const Geography& geog, MutableS2ShapeIndex* index) {
+  switch (geog.kind()) {
+    case GeographyKind::POINT: {
+      const auto& point = static_cast<const PointGeography&>(geog);
+      index->Add(absl::make_unique<S2PointVectorShape>(point.Points()));
+      break;
+    }
+
+    case GeographyKind::POLYLINE: {
+      const auto& polyline = static_cast<const PolylineGeography&>(geog);
+      for (const auto& item : polyline.Polylines()) {
+        index->Add(absl::make_unique<S2LaxPolylineShape>(*item));
+      }
+      break;
+    }
+
+    case GeographyKind::POLYGON: {
+      const auto& polygon = static_cast<const PolygonGeography&>(geog);
+      index->Add(absl::make_unique<S2LaxPolygonShape>(*polygon.Polygon()));
+      break;
+    }
+
+    case GeographyKind::GEOGRAPHY_COLLECTION: {
+      const auto& collection = static_cast<const GeographyCollection&>(geog);
+      for (const auto& feature : collection.Features()) {
+        AddLaxShapes(*feature, index);
+      }
+      break;
+    }
+
+    default:
+      for (int i = 0; i < geog.num_shapes(); i++) {
+        AddLaxShape(*geog.ShapeView(i), index);
+      }
+      break;
+  }
+}
+
+}  // namespace
+
+void EncodeGeography(const Geography& geog, Encoder* encoder,
+                     const ShapeIndexGeography* index) {
+  // An index built from geog doesn't match the shapes of its rebuilt
+  // version, so the index is rebuilt as well
+  if (index != nullptr && !HasNativeEncoding(geog)) {
+    std::unique_ptr<Geography> rebuilt = s2_rebuild(geog, GlobalOptions());
+    ShapeIndexGeography rebuilt_index(*rebuilt);
+    EncodeGeography(*rebuilt, encoder, &rebuilt_index);
+    return;
+  }
+
+  encoder->Ensure(2);
+  encoder->put8(kCurrentEncodingVersion);
+  encoder->put8(index == nullptr ? 0 : kFlagHasIndex);
+
+  EncodeFeature(geog, encoder);
+  if (index != nullptr) {
+    index->EncodeIndex(encoder);
+  }
+}
+
+std::unique_ptr<Geography> DecodeGeography(
+    Decoder* decoder, std::unique_ptr<ShapeIndexGeography>* index) {
+  CheckDecoded(decoder->avail() >= 2, "geography header");
+  uint8_t version = decoder->get8();
+  if (version != kCurrentEncodingVersion) {
+    std::stringstream err;
+    err << "Unsupported geography encoding version: "
+        << static_cast<int>(version);
+    throw Exception(err.str());
+  }
+
+  uint8_t flags = decoder->get8();
+  std::unique_ptr<Geography> geog = DecodeFeature(decoder);
+
+  if ((flags & kFlagHasIndex) && index != nullptr) {
+    auto decoded_index = absl::make_unique<ShapeIndexGeography>();
+    CheckDecoded(decoded_index->DecodeIndex(decoder, *geog), "shape index");
+    *index = std::move(decoded_index);
+  }
+
+  return geog;
+}
+
+void EncodeShapeIndex(const Geography& geog, Encoder* encoder) {
+  MutableS2ShapeIndex index;
+  AddLaxShapes(geog, &index);
+
+  if (!s2shapeutil::FastEncodeTaggedShapes(index, encoder)) {
+    throw Exception("Failed to encode shapes");
+  }
+  index.Encode(encoder);
+}
+
+}  // namespace util
+
+}  // namespace s2geography
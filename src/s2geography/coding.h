@@ -0,0 +1,41 @@
+
+#pragma once
+
+#include <memory>
+
+#include "geography.h"
+
+namespace s2geography {
+
+namespace util {
+
+// Encodes geog using S2's native encodings: points are written with
+// EncodeS2PointVector(), polylines with S2Polyline::EncodeMostCompact(), and
+// polygons with S2Polygon::Encode() (which uses a compressed encoding when
+// vertices are snapped to cell centers). If index is non-null, the encoded
+// shape index structure is appended so that it does not have to be rebuilt
+// after decoding; index must have been built from geog. Other Geography
+// subclasses (e.g., EncodedShapeIndexGeography) are rebuilt with s2_rebuild()
+// and encoded as the result (with an index built from it if requested).
+void EncodeGeography(const Geography& geog, Encoder* encoder,
+                     const ShapeIndexGeography* index = nullptr);
+
+// Decodes a Geography encoded with EncodeGeography(). Decoded features are
+// not re-validated. If the encoding contains a shape index and index is
+// non-null, the decoded index is placed in index (its shapes point to the
+// returned Geography, which must outlive it). Throws an Exception if the
+// encoding is invalid.
+std::unique_ptr<Geography> DecodeGeography(
+    Decoder* decoder, std::unique_ptr<ShapeIndexGeography>* index = nullptr);
+
+// Encodes the shapes of geog and a shape index built from them in a form
+// that can be read lazily by EncodedShapeIndexGeography::Init(). Polygons and
+// polylines are converted to S2LaxPolygonShape and S2LaxPolylineShape and
+// written with s2shapeutil::FastEncodeTaggedShapes() so that they can be
+// accessed without being decoded. The result is not meant to be converted
+// back to its original Geography subclass (use EncodeGeography() for that).
+void EncodeShapeIndex(const Geography& geog, Encoder* encoder);
+
+}  // namespace util
+
+}  // namespace s2geography
@@ -272,6 +272,24 @@ class PolygonConstructor : public Constructor {
     return std::unique_ptr<Geography>(result.release());
   }
 
+  // Runs the checks that are run with Options::check() on a polygon that
+  // was built without them. Loops are numbered in the order they appear
+  // in the polygon (which is not necessarily the order they were added).
+  static void Check(const S2Polygon& polygon) {
+    S2Error error;
+    for (int i = 0; i < polygon.num_loops(); i++) {
+      if (polygon.loop(i)->FindValidationError(&error)) {
+        std::stringstream err;
+        err << "Loop " << i << " is not valid: " << error.text();
+        throw Exception(err.str());
+      }
+    }
+
+    if (polygon.FindValidationError(&error)) {
+      throw Exception(error.text());
+    }
+  }
+
  private:
   std::vector<std::unique_ptr<S2Loop>> loops_;
   S2Error error_;
@@ -405,6 +423,21 @@ class FeatureConstructor : public CollectionConstructor {
   }
 };
 
+// Runs the checks that a FeatureConstructor with Options::check() would
+// have run on a feature that was built without them. This allows the
+// (potentially expensive) validation to be separated from construction
+// (e.g., to validate many features in parallel). Throws an Exception
+// describing the first error.
+inline void CheckFeature(const Geography& geog) {
+  if (auto polygon = geography_cast<PolygonGeography>(&geog)) {
+    PolygonConstructor::Check(*polygon->Polygon());
+  } else if (auto collection = geography_cast<GeographyCollection>(&geog)) {
+    for (const auto& feature : collection->Features()) {
+      CheckFeature(*feature);
+    }
+  }
+}
+
 }  // namespace util
 
 }  // namespace s2geography
@@ -42,7 +42,7 @@ S2Point s2_point_on_surface(const Geography& geog, S2RegionCoverer& coverer) {
     S1Angle dist;
     S2Point closest_pt;
     for (int i = 0; i < geog.num_shapes(); i++) {
-      auto shape = geog.Shape(i);
+      const S2Shape* shape = geog.ShapeView(i);
       for (int j = 0; j < shape->num_edges(); j++) {
         S2Shape::Edge e = shape->edge(j);
         dist = S1Angle(e.v0, centroid);
@@ -3,6 +3,7 @@
 
 #include <s2/s2closest_edge_query.h>
 #include <s2/s2furthest_edge_query.h>
+#include <s2/s2predicates.h>
 
 #include "geography.h"
 
@@ -10,24 +11,14 @@ namespace s2geography {
 
 double s2_distance(const ShapeIndexGeography& geog1,
                    const ShapeIndexGeography& geog2) {
-  S2ClosestEdgeQuery query(&geog1.ShapeIndex());
-  S2ClosestEdgeQuery::ShapeIndexTarget target(&geog2.ShapeIndex());
-
-  const auto& result = query.FindClosestEdge(&target);
-
-  S1ChordAngle angle = result.distance();
-  return angle.ToAngle().radians();
+  PairwiseDistance distance;
+  return distance.Distance(geog1, geog2);
 }
 
 double s2_max_distance(const ShapeIndexGeography& geog1,
                        const ShapeIndexGeography& geog2) {
-  S2FurthestEdgeQuery query(&geog1.ShapeIndex());
-  S2FurthestEdgeQuery::ShapeIndexTarget target(&geog2.ShapeIndex());
-
-  const auto& result = query.FindFurthestEdge(&target);
-
-  S1ChordAngle angle = result.distance();
-  return angle.ToAngle().radians();
+  PairwiseMaxDistance distance;
+  return distance.MaxDistance(geog1, geog2);
 }
 
 S2Point s2_closest_point(const ShapeIndexGeography& geog1,
@@ -37,34 +28,172 @@ S2Point s2_closest_point(const ShapeIndexGeography& geog1,
 
 std::pair<S2Point, S2Point> s2_minimum_clearance_line_between(
     const ShapeIndexGeography& geog1, const ShapeIndexGeography& geog2) {
-  S2ClosestEdgeQuery query1(&geog1.ShapeIndex());
-  query1.mutable_options()->set_include_interiors(false);
-  S2ClosestEdgeQuery::ShapeIndexTarget target(&geog2.ShapeIndex());
+  PairwiseDistance distance;
+  return distance.MinimumClearanceLineBetween(geog1, geog2);
+}
+
+void PairwiseDistance::Prepare(const ShapeIndexGeography& geog1,
+                               const ShapeIndexGeography& geog2) {
+  if (&geog1 != geog1_) {
+    query1_ = absl::make_unique<S2ClosestEdgeQuery>(&geog1.ShapeIndex());
+    geog1_ = &geog1;
+  }
+
+  if (&geog2 != geog2_) {
+    target2_ = absl::make_unique<S2ClosestEdgeQuery::ShapeIndexTarget>(
+        &geog2.ShapeIndex());
+    query2_.reset();
+    geog2_ = &geog2;
+  }
+
+  query1_->mutable_options()->set_max_error(S1Angle::Radians(max_error_));
+}
+
+double PairwiseDistance::Distance(const ShapeIndexGeography& geog1,
+                                  const ShapeIndexGeography& geog2) {
+  Prepare(geog1, geog2);
+  query1_->mutable_options()->set_include_interiors(true);
+
+  const auto& result = query1_->FindClosestEdge(target2_.get());
+
+  S1ChordAngle angle = result.distance();
+  return angle.ToAngle().radians();
+}
+
+S2Point PairwiseDistance::ClosestPoint(const ShapeIndexGeography& geog1,
+                                       const ShapeIndexGeography& geog2) {
+  return MinimumClearanceLineBetween(geog1, geog2).first;
+}
+
+std::pair<S2Point, S2Point> PairwiseDistance::MinimumClearanceLineBetween(
+    const ShapeIndexGeography& geog1, const ShapeIndexGeography& geog2) {
+  Prepare(geog1, geog2);
+  query1_->mutable_options()->set_include_interiors(false);
 
-  const auto& result1 = query1.FindClosestEdge(&target);
+  const auto& result1 = query1_->FindClosestEdge(target2_.get());
 
   if (result1.edge_id() == -1) {
     return std::pair<S2Point, S2Point>(S2Point(0, 0, 0), S2Point(0, 0, 0));
   }
 
   // Get the edge from index1 (edge1) that is closest to index2.
-  S2Shape::Edge edge1 = query1.GetEdge(result1);
+  S2Shape::Edge edge1 = query1_->GetEdge(result1);
 
   // Now find the edge from index2 (edge2) that is closest to edge1.
-  S2ClosestEdgeQuery query2(&geog2.ShapeIndex());
-  query2.mutable_options()->set_include_interiors(false);
+  if (!query2_) {
+    query2_ = absl::make_unique<S2ClosestEdgeQuery>(&geog2.ShapeIndex());
+    query2_->mutable_options()->set_include_interiors(false);
+  }
+
+  query2_->mutable_options()->set_max_error(S1Angle::Radians(max_error_));
+
   S2ClosestEdgeQuery::EdgeTarget target2(edge1.v0, edge1.v1);
-  auto result2 = query2.FindClosestEdge(&target2);
+  auto result2 = query2_->FindClosestEdge(&target2);
 
   // what if result2 has no edges?
   if (result2.is_interior()) {
     throw Exception("S2ClosestEdgeQuery result is interior!");
   }
 
-  S2Shape::Edge edge2 = query2.GetEdge(result2);
+  S2Shape::Edge edge2 = query2_->GetEdge(result2);
 
   // Find the closest point pair on edge1 and edge2.
   return S2::GetEdgePairClosestPoints(edge1.v0, edge1.v1, edge2.v0, edge2.v1);
 }
 
+double PairwiseMaxDistance::MaxDistance(const ShapeIndexGeography& geog1,
+                                        const ShapeIndexGeography& geog2) {
+  if (&geog1 != geog1_) {
+    query1_ = absl::make_unique<S2FurthestEdgeQuery>(&geog1.ShapeIndex());
+    geog1_ = &geog1;
+  }
+
+  if (&geog2 != geog2_) {
+    target2_ = absl::make_unique<S2FurthestEdgeQuery::ShapeIndexTarget>(
+        &geog2.ShapeIndex());
+    geog2_ = &geog2;
+  }
+
+  query1_->mutable_options()->set_max_error(S1Angle::Radians(max_error_));
+  const auto& result = query1_->FindFurthestEdge(target2_.get());
+
+  S1ChordAngle angle = result.distance();
+  return angle.ToAngle().radians();
+}
+
+namespace {
+
+// Follows S2HausdorffDistanceQuery::GetDirectedResult(), except that each
+// closest edge query is limited to max_distance so that the loop can stop
+// at the first vertex of target that is further than max_distance from
+// source
+S1ChordAngle DirectedHausdorffDistance(const S2ShapeIndex& target,
+                                       const S2ShapeIndex& source,
+                                       S1ChordAngle max_distance) {
+  S2ClosestEdgeQuery query(&source);
+  query.mutable_options()->set_max_results(1);
+  if (max_distance < S1ChordAngle::Infinity()) {
+    query.mutable_options()->set_inclusive_max_distance(max_distance);
+  }
+
+  S1ChordAngle distance = S1ChordAngle::Negative();
+  S2Point source_point;
+
+  for (const S2Shape* shape : target) {
+    for (auto chain : shape->chains()) {
+      for (const S2Point& vertex : shape->vertices(chain)) {
+        // a vertex that is no further from the source point of the current
+        // maximum than the current maximum can't increase the distance
+        if (!distance.is_negative() &&
+            s2pred::CompareDistance(vertex, source_point, distance) <= 0) {
+          continue;
+        }
+
+        S2ClosestEdgeQuery::PointTarget point_target(vertex);
+        const auto& result = query.FindClosestEdge(&point_target);
+        if (result.is_empty()) {
+          return S1ChordAngle::Infinity();
+        }
+
+        if (distance < result.distance()) {
+          distance = result.distance();
+          source_point = query.Project(vertex, result);
+        }
+      }
+    }
+  }
+
+  if (distance.is_negative()) {
+    return S1ChordAngle::Infinity();
+  } else {
+    return distance;
+  }
+}
+
+}  // namespace
+
+double s2_directed_hausdorff_distance(const ShapeIndexGeography& geog1,
+                                      const ShapeIndexGeography& geog2,
+                                      double max_distance) {
+  S1ChordAngle distance = DirectedHausdorffDistance(
+      geog1.ShapeIndex(), geog2.ShapeIndex(),
+      S1ChordAngle(S1Angle::Radians(max_distance)));
+  return distance.ToAngle().radians();
+}
+
+double s2_hausdorff_distance(const ShapeIndexGeography& geog1,
+                             const ShapeIndexGeography& geog2,
+                             double max_distance) {
+  S1ChordAngle limit(S1Angle::Radians(max_distance));
+  S1ChordAngle distance1 =
+      DirectedHausdorffDistance(geog1.ShapeIndex(), geog2.ShapeIndex(), limit);
+  if (distance1 == S1ChordAngle::Infinity()) {
+    return distance1.ToAngle().radians();
+  }
+
+  S1ChordAngle distance2 =
+      DirectedHausdorffDistance(geog2.ShapeIndex(), geog1.ShapeIndex(), limit);
+  return std::max(distance1, distance2).ToAngle().radians();
+}
+
 }  // namespace s2geography
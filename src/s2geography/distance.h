@@ -1,6 +1,11 @@
 
 #pragma once
 
+#include <limits>
+
+#include <s2/s2closest_edge_query.h>
+#include <s2/s2furthest_edge_query.h>
+
 #include "geography.h"
 
 namespace s2geography {
@@ -14,4 +19,69 @@ S2Point s2_closest_point(const ShapeIndexGeography& geog1,
 std::pair<S2Point, S2Point> s2_minimum_clearance_line_between(
     const ShapeIndexGeography& geog1, const ShapeIndexGeography& geog2);
 
+// Distance calculations for many pairs of geographies. The query built on
+// the first geography and the target built on the second geography are
+// reused when consecutive pairs share them (e.g., when one side was recycled
+// from a single feature). A max_error (in radians) greater than zero allows
+// the query to stop as soon as it has found an edge that is within max_error
+// of the closest edge, so that distances may be up to max_error too large.
+class PairwiseDistance {
+ public:
+  explicit PairwiseDistance(double max_error = 0) : max_error_(max_error) {}
+  void set_max_error(double max_error) { max_error_ = max_error; }
+
+  // Returns Inf if either geography is empty
+  double Distance(const ShapeIndexGeography& geog1,
+                  const ShapeIndexGeography& geog2);
+
+  // Returns a pair of zero-length points if either geography is empty
+  std::pair<S2Point, S2Point> MinimumClearanceLineBetween(
+      const ShapeIndexGeography& geog1, const ShapeIndexGeography& geog2);
+  S2Point ClosestPoint(const ShapeIndexGeography& geog1,
+                       const ShapeIndexGeography& geog2);
+
+ private:
+  double max_error_;
+  const ShapeIndexGeography* geog1_ = nullptr;
+  const ShapeIndexGeography* geog2_ = nullptr;
+  std::unique_ptr<S2ClosestEdgeQuery> query1_;
+  std::unique_ptr<S2ClosestEdgeQuery> query2_;
+  std::unique_ptr<S2ClosestEdgeQuery::ShapeIndexTarget> target2_;
+
+  void Prepare(const ShapeIndexGeography& geog1,
+               const ShapeIndexGeography& geog2);
+};
+
+// Like PairwiseDistance, but for the maximum distance between two
+// geographies (distances may be up to max_error too small)
+class PairwiseMaxDistance {
+ public:
+  explicit PairwiseMaxDistance(double max_error = 0)
+      : max_error_(max_error) {}
+  void set_max_error(double max_error) { max_error_ = max_error; }
+
+  // Returns -1 if either geography is empty
+  double MaxDistance(const ShapeIndexGeography& geog1,
+                     const ShapeIndexGeography& geog2);
+
+ private:
+  double max_error_;
+  const ShapeIndexGeography* geog1_ = nullptr;
+  const ShapeIndexGeography* geog2_ = nullptr;
+  std::unique_ptr<S2FurthestEdgeQuery> query1_;
+  std::unique_ptr<S2FurthestEdgeQuery::ShapeIndexTarget> target2_;
+};
+
+// The discrete Hausdorff distance (see S2HausdorffDistanceQuery) in radians
+// from the vertices of geog1 to geog2 (directed) or the maximum of both
+// directions. If max_distance is finite, the computation stops as soon as
+// the distance is known to exceed it and returns Inf. Also returns Inf if
+// either geography is empty.
+double s2_directed_hausdorff_distance(
+    const ShapeIndexGeography& geog1, const ShapeIndexGeography& geog2,
+    double max_distance = std::numeric_limits<double>::infinity());
+double s2_hausdorff_distance(
+    const ShapeIndexGeography& geog1, const ShapeIndexGeography& geog2,
+    double max_distance = std::numeric_limits<double>::infinity());
+
 }  // namespace s2geography
@@ -9,6 +9,9 @@
 // useful and allowed me to re-use the WKT and WKB readers and
 // writers that I refactored to suit that library).
 
+// Defined by the Arrow C Data interface (see geoarrow.h)
+struct ArrowArray;
+
 namespace s2geography {
 
 namespace util {
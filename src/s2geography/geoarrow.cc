@@ -0,0 +1,814 @@
+
+#include "geoarrow.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+#include "build.h"
+
+namespace s2geography {
+
+namespace util {
+
+namespace {
+
+// Returns the value of key in serialized Arrow schema metadata or an empty
+// string if key is not present.
+std::string SchemaMetadataValue(const char* metadata, const std::string& key) {
+  if (metadata == nullptr) {
+    return "";
+  }
+
+  int32_t n_pairs;
+  memcpy(&n_pairs, metadata, sizeof(int32_t));
+  metadata += sizeof(int32_t);
+
+  for (int32_t i = 0; i < n_pairs; i++) {
+    int32_t key_size;
+    memcpy(&key_size, metadata, sizeof(int32_t));
+    metadata += sizeof(int32_t);
+    std::string this_key(metadata, key_size);
+    metadata += key_size;
+
+    int32_t value_size;
+    memcpy(&value_size, metadata, sizeof(int32_t));
+    metadata += sizeof(int32_t);
+    std::string value(metadata, value_size);
+    metadata += value_size;
+
+    if (this_key == key) {
+      return value;
+    }
+  }
+
+  return "";
+}
+
+// Returns the string value of key in a flat JSON object (e.g., geoarrow
+// extension metadata) or an empty string if key is not present.
+std::string JsonStringValue(const std::string& json, const std::string& key) {
+  size_t pos = json.find("\"" + key + "\"");
+  if (pos == std::string::npos) {
+    return "";
+  }
+
+  pos = json.find(':', pos + key.size() + 2);
+  size_t start = pos == std::string::npos ? pos : json.find('"', pos + 1);
+  size_t end = start == std::string::npos ? start : json.find('"', start + 1);
+  if (end == std::string::npos) {
+    return "";
+  }
+
+  return json.substr(start + 1, end - start - 1);
+}
+
+void AppendMetadataInt32(std::string* metadata, int32_t value) {
+  metadata->append(reinterpret_cast<const char*>(&value), sizeof(int32_t));
+}
+
+void AppendMetadataPair(std::string* metadata, const std::string& key,
+                        const std::string& value) {
+  AppendMetadataInt32(metadata, key.size());
+  metadata->append(key);
+  AppendMetadataInt32(metadata, value.size());
+  metadata->append(value);
+}
+
+// Number of nested list levels between the array and its coordinates
+int NumLevels(GeometryType geometry_type) {
+  switch (geometry_type) {
+    case GeometryType::POINT:
+      return 0;
+    case GeometryType::LINESTRING:
+    case GeometryType::MULTIPOINT:
+      return 1;
+    case GeometryType::POLYGON:
+    case GeometryType::MULTILINESTRING:
+      return 2;
+    case GeometryType::MULTIPOLYGON:
+      return 3;
+    default:
+      throw Exception("Unsupported geometry type for geoarrow array");
+  }
+}
+
+std::vector<std::string> LevelNames(GeometryType geometry_type) {
+  switch (geometry_type) {
+    case GeometryType::POINT:
+      return {};
+    case GeometryType::LINESTRING:
+      return {"vertices"};
+    case GeometryType::POLYGON:
+      return {"rings", "vertices"};
+    case GeometryType::MULTIPOINT:
+      return {"points"};
+    case GeometryType::MULTILINESTRING:
+      return {"linestrings", "vertices"};
+    case GeometryType::MULTIPOLYGON:
+      return {"polygons", "rings", "vertices"};
+    default:
+      throw Exception("Unsupported geometry type for geoarrow array");
+  }
+}
+
+const char* ExtensionName(GeometryType geometry_type) {
+  switch (geometry_type) {
+    case GeometryType::POINT:
+      return "geoarrow.point";
+    case GeometryType::LINESTRING:
+      return "geoarrow.linestring";
+    case GeometryType::POLYGON:
+      return "geoarrow.polygon";
+    case GeometryType::MULTIPOINT:
+      return "geoarrow.multipoint";
+    case GeometryType::MULTILINESTRING:
+      return "geoarrow.multilinestring";
+    case GeometryType::MULTIPOLYGON:
+      return "geoarrow.multipolygon";
+    default:
+      throw Exception("Unsupported geometry type for geoarrow array");
+  }
+}
+
+struct SchemaPrivate {
+  std::string format;
+  std::string name;
+  std::string metadata;
+  std::vector<struct ArrowSchema*> children;
+};
+
+void ReleaseSchema(struct ArrowSchema* schema) {
+  auto private_data = reinterpret_cast<SchemaPrivate*>(schema->private_data);
+  for (struct ArrowSchema* child : private_data->children) {
+    if (child->release != nullptr) {
+      child->release(child);
+    }
+    delete child;
+  }
+
+  delete private_data;
+  schema->release = nullptr;
+}
+
+void InitSchemaNode(struct ArrowSchema* schema, const std::string& format,
+                    const std::string& name, const std::string& metadata,
+                    int64_t n_children) {
+  auto private_data = new SchemaPrivate();
+  private_data->format = format;
+  private_data->name = name;
+  private_data->metadata = metadata;
+  for (int64_t i = 0; i < n_children; i++) {
+    auto child = new struct ArrowSchema;
+    child->release = nullptr;
+    private_data->children.push_back(child);
+  }
+
+  schema->format = private_data->format.c_str();
+  schema->name = private_data->name.c_str();
+  schema->metadata =
+      private_data->metadata.empty() ? nullptr : private_data->metadata.data();
+  schema->flags = ARROW_FLAG_NULLABLE;
+  schema->n_children = n_children;
+  schema->children = private_data->children.data();
+  schema->dictionary = nullptr;
+  schema->release = &ReleaseSchema;
+  schema->private_data = private_data;
+}
+
+struct ArrayPrivate {
+  std::vector<uint8_t> validity;
+  std::vector<int32_t> offsets;
+  std::vector<double> values;
+  std::vector<const void*> buffers;
+  std::vector<struct ArrowArray*> children;
+};
+
+void ReleaseArray(struct ArrowArray* array) {
+  auto private_data = reinterpret_cast<ArrayPrivate*>(array->private_data);
+  for (struct ArrowArray* child : private_data->children) {
+    if (child->release != nullptr) {
+      child->release(child);
+    }
+    delete child;
+  }
+
+  delete private_data;
+  array->release = nullptr;
+}
+
+ArrayPrivate* InitArrayNode(struct ArrowArray* array, int64_t length,
+                            int64_t n_children) {
+  auto private_data = new ArrayPrivate();
+  for (int64_t i = 0; i < n_children; i++) {
+    auto child = new struct ArrowArray;
+    child->release = nullptr;
+    private_data->children.push_back(child);
+  }
+
+  array->length = length;
+  array->null_count = 0;
+  array->offset = 0;
+  array->n_buffers = 0;
+  array->buffers = nullptr;
+  array->n_children = n_children;
+  array->children = private_data->children.data();
+  array->dictionary = nullptr;
+  array->release = &ReleaseArray;
+  array->private_data = private_data;
+  return private_data;
+}
+
+// geoarrow.point/linestring/polygon/multi* use 32-bit list offsets
+int32_t CheckedOffset(size_t value) {
+  if (value > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+    throw Exception(
+        "Can't write more than 2^31 - 1 coordinates or parts to a geoarrow array");
+  }
+
+  return static_cast<int32_t>(value);
+}
+
+void SetArrayBuffers(struct ArrowArray* array, ArrayPrivate* private_data) {
+  array->n_buffers = private_data->buffers.size();
+  array->buffers = private_data->buffers.data();
+}
+
+}  // namespace
+
+void GeoArrowReader::Init(const struct ArrowSchema* schema) {
+  std::string extension_name =
+      SchemaMetadataValue(schema->metadata, "ARROW:extension:name");
+  std::string format(schema->format);
+
+  std::string extension_metadata =
+      SchemaMetadataValue(schema->metadata, "ARROW:extension:metadata");
+  std::string edges = JsonStringValue(extension_metadata, "edges");
+  if (extension_metadata.empty()) {
+    edges_ = Edges::UNSPECIFIED;
+  } else if (edges.empty() || edges == "planar") {
+    edges_ = Edges::PLANAR;
+  } else if (edges == "spherical") {
+    edges_ = Edges::SPHERICAL;
+  } else {
+    throw Exception("Unsupported geoarrow edge type: '" + edges + "'");
+  }
+
+  wkb_ = false;
+  large_wkb_ = false;
+  if (extension_name == "geoarrow.point") {
+    geometry_type_ = GeometryType::POINT;
+  } else if (extension_name == "geoarrow.linestring") {
+    geometry_type_ = GeometryType::LINESTRING;
+  } else if (extension_name == "geoarrow.polygon") {
+    geometry_type_ = GeometryType::POLYGON;
+  } else if (extension_name == "geoarrow.multipoint") {
+    geometry_type_ = GeometryType::MULTIPOINT;
+  } else if (extension_name == "geoarrow.multilinestring") {
+    geometry_type_ = GeometryType::MULTILINESTRING;
+  } else if (extension_name == "geoarrow.multipolygon") {
+    geometry_type_ = GeometryType::MULTIPOLYGON;
+  } else if (extension_name == "geoarrow.wkb") {
+    geometry_type_ = GeometryType::GEOMETRY_TYPE_UNKNOWN;
+    wkb_ = true;
+    if (format == "Z") {
+      large_wkb_ = true;
+    } else if (format != "z") {
+      throw Exception("Expected geoarrow.wkb with storage type binary or large_binary");
+    }
+
+    return;
+  } else if (extension_name.empty()) {
+    throw Exception("Expected geoarrow extension type but found Arrow type with format '" +
+                    format + "'");
+  } else {
+    throw Exception("Unsupported extension type: '" + extension_name + "'");
+  }
+
+  n_levels_ = NumLevels(geometry_type_);
+  for (int level = 0; level < n_levels_; level++) {
+    if (std::string(schema->format) != "+l" || schema->n_children != 1) {
+      throw Exception("Expected list storage for " + extension_name +
+                      " but found format '" + schema->format + "'");
+    }
+
+    schema = schema->children[0];
+  }
+
+  format = schema->format;
+  if (format.size() > 3 && format.substr(0, 3) == "+w:") {
+    interleaved_ = true;
+    coord_size_ = std::stoi(format.substr(3));
+    if (schema->n_children != 1 || std::string(schema->children[0]->format) != "g") {
+      throw Exception("Expected fixed-size list of double for interleaved coordinates");
+    }
+  } else if (format == "+s") {
+    interleaved_ = false;
+    coord_size_ = schema->n_children;
+    for (int64_t i = 0; i < schema->n_children; i++) {
+      if (std::string(schema->children[i]->format) != "g") {
+        throw Exception("Expected struct of double for separated coordinates");
+      }
+    }
+  } else {
+    throw Exception("Unsupported coordinate storage with format '" + format + "'");
+  }
+
+  if (coord_size_ < 2 || coord_size_ > 4) {
+    std::stringstream err;
+    err << "Unsupported number of coordinate dimensions: " << coord_size_;
+    throw Exception(err.str());
+  }
+
+  separated_values_.resize(interleaved_ ? 0 : coord_size_);
+  scratch_.resize(coord_size_);
+}
+
+void GeoArrowReader::SetArray(const struct ArrowArray* array) {
+  length_ = array->length;
+  offset_ = array->offset;
+  validity_ = array->n_buffers > 0
+                  ? reinterpret_cast<const uint8_t*>(array->buffers[0])
+                  : nullptr;
+
+  if (wkb_) {
+    if (array->n_buffers != 3) {
+      throw Exception("Expected 3 buffers for geoarrow.wkb array");
+    }
+
+    wkb_data_ = reinterpret_cast<const uint8_t*>(array->buffers[2]);
+    if (large_wkb_) {
+      large_wkb_offsets_ =
+          reinterpret_cast<const int64_t*>(array->buffers[1]) + array->offset;
+    } else {
+      wkb_offsets_ =
+          reinterpret_cast<const int32_t*>(array->buffers[1]) + array->offset;
+    }
+
+    return;
+  }
+
+  for (int level = 0; level < n_levels_; level++) {
+    if (array->n_buffers != 2 || array->n_children != 1) {
+      throw Exception("Unexpected layout for geoarrow list array");
+    }
+
+    offsets_[level] =
+        reinterpret_cast<const int32_t*>(array->buffers[1]) + array->offset;
+    array = array->children[0];
+  }
+
+  SetCoordArray(array);
+}
+
+void GeoArrowReader::SetCoordArray(const struct ArrowArray* array) {
+  if (interleaved_) {
+    if (array->n_children != 1 || array->children[0]->n_buffers != 2) {
+      throw Exception("Unexpected layout for interleaved coordinate array");
+    }
+
+    const struct ArrowArray* values = array->children[0];
+    interleaved_values_ = reinterpret_cast<const double*>(values->buffers[1]) +
+                          values->offset + array->offset * coord_size_;
+  } else {
+    if (array->n_children != coord_size_) {
+      throw Exception("Unexpected layout for separated coordinate array");
+    }
+
+    for (int32_t i = 0; i < coord_size_; i++) {
+      const struct ArrowArray* values = array->children[i];
+      if (values->n_buffers != 2) {
+        throw Exception("Unexpected layout for separated coordinate array");
+      }
+
+      separated_values_[i] = reinterpret_cast<const double*>(values->buffers[1]) +
+                             values->offset + array->offset;
+    }
+  }
+}
+
+bool GeoArrowReader::IsNull(int64_t i) const {
+  if (validity_ == nullptr) {
+    return false;
+  }
+
+  int64_t bit = offset_ + i;
+  return !((validity_[bit / 8] >> (bit % 8)) & 0x01);
+}
+
+void GeoArrowReader::ReadGeometry(int64_t i) {
+  if (wkb_) {
+    if (large_wkb_) {
+      int64_t begin = large_wkb_offsets_[i];
+      wkb_reader_.ReadGeometry(wkb_data_ + begin, large_wkb_offsets_[i + 1] - begin);
+    } else {
+      int64_t begin = wkb_offsets_[i];
+      wkb_reader_.ReadGeometry(wkb_data_ + begin, wkb_offsets_[i + 1] - begin);
+    }
+
+    return;
+  }
+
+  switch (geometry_type_) {
+    case GeometryType::POINT:
+      ReadPoint(i);
+      break;
+    case GeometryType::LINESTRING:
+      ReadLinestring(0, i);
+      break;
+    case GeometryType::POLYGON:
+      ReadPolygon(0, i);
+      break;
+    case GeometryType::MULTIPOINT:
+    case GeometryType::MULTILINESTRING:
+    case GeometryType::MULTIPOLYGON: {
+      int64_t begin = offsets_[0][i];
+      int64_t end = offsets_[0][i + 1];
+      handler_->geom_start(geometry_type_, end - begin);
+      for (int64_t j = begin; j < end; j++) {
+        if (geometry_type_ == GeometryType::MULTIPOINT) {
+          ReadPoint(j);
+        } else if (geometry_type_ == GeometryType::MULTILINESTRING) {
+          ReadLinestring(1, j);
+        } else {
+          ReadPolygon(1, j);
+        }
+      }
+      handler_->geom_end();
+      break;
+    }
+    default:
+      throw Exception("Unexpected geometry type in GeoArrowReader");
+  }
+}
+
+void GeoArrowReader::ReadCoords(int64_t begin, int64_t end) {
+  int64_t n = end - begin;
+  if (n <= 0) {
+    return;
+  }
+
+  if (interleaved_) {
+    handler_->coords(interleaved_values_ + begin * coord_size_, n, coord_size_);
+    return;
+  }
+
+  scratch_.resize(n * coord_size_);
+  for (int64_t i = 0; i < n; i++) {
+    for (int32_t j = 0; j < coord_size_; j++) {
+      scratch_[i * coord_size_ + j] = separated_values_[j][begin + i];
+    }
+  }
+
+  handler_->coords(scratch_.data(), n, coord_size_);
+}
+
+void GeoArrowReader::ReadPoint(int64_t i) {
+  bool empty = true;
+  for (int32_t j = 0; j < coord_size_; j++) {
+    double value = interleaved_ ? interleaved_values_[i * coord_size_ + j]
+                                : separated_values_[j][i];
+    empty = empty && std::isnan(value);
+  }
+
+  handler_->geom_start(GeometryType::POINT, empty ? 0 : 1);
+  if (!empty) {
+    ReadCoords(i, i + 1);
+  }
+  handler_->geom_end();
+}
+
+void GeoArrowReader::ReadLinestring(int level, int64_t i) {
+  int64_t begin = offsets_[level][i];
+  int64_t end = offsets_[level][i + 1];
+  handler_->geom_start(GeometryType::LINESTRING, end - begin);
+  ReadCoords(begin, end);
+  handler_->geom_end();
+}
+
+void GeoArrowReader::ReadPolygon(int level, int64_t i) {
+  int64_t begin = offsets_[level][i];
+  int64_t end = offsets_[level][i + 1];
+  handler_->geom_start(GeometryType::POLYGON, end - begin);
+  for (int64_t j = begin; j < end; j++) {
+    int64_t coord_begin = offsets_[level + 1][j];
+    int64_t coord_end = offsets_[level + 1][j + 1];
+    handler_->ring_start(coord_end - coord_begin);
+    ReadCoords(coord_begin, coord_end);
+    handler_->ring_end();
+  }
+  handler_->geom_end();
+}
+
+GeoArrowWriter::GeoArrowWriter(GeometryType geometry_type,
+                               const Constructor::Options& options)
+    : geometry_type_(geometry_type),
+      options_(options),
+      n_levels_(NumLevels(geometry_type)),
+      length_(0),
+      null_count_(0) {
+  if (options_.projection() == nullptr) {
+    throw Exception("GeoArrowWriter requires a projection");
+  }
+
+  if (options_.tessellate_tolerance() != S1Angle::Infinity()) {
+    tessellator_ = absl::make_unique<S2EdgeTessellator>(
+        options_.projection(), options_.tessellate_tolerance());
+  }
+
+  for (int level = 0; level < n_levels_; level++) {
+    offsets_[level].push_back(0);
+  }
+}
+
+GeometryType GeoArrowWriter::FeatureGeometryType(const Geography& geog) {
+  switch (geog.kind()) {
+    case GeographyKind::POINT: {
+      const auto& point = static_cast<const PointGeography&>(geog);
+      switch (point.Points().size()) {
+        case 0:
+          return GeometryType::GEOMETRY_TYPE_UNKNOWN;
+        case 1:
+          return GeometryType::POINT;
+        default:
+          return GeometryType::MULTIPOINT;
+      }
+    }
+
+    case GeographyKind::POLYLINE: {
+      const auto& polyline = static_cast<const PolylineGeography&>(geog);
+      switch (polyline.Polylines().size()) {
+        case 0:
+          return GeometryType::GEOMETRY_TYPE_UNKNOWN;
+        case 1:
+          return GeometryType::LINESTRING;
+        default:
+          return GeometryType::MULTILINESTRING;
+      }
+    }
+
+    case GeographyKind::POLYGON: {
+      const auto& polygon = static_cast<const PolygonGeography&>(geog);
+      int num_shells = 0;
+      for (int i = 0; i < polygon.Polygon()->num_loops(); i++) {
+        num_shells += (polygon.Polygon()->loop(i)->depth() % 2) == 0;
+      }
+
+      switch (num_shells) {
+        case 0:
+          return GeometryType::GEOMETRY_TYPE_UNKNOWN;
+        case 1:
+          return GeometryType::POLYGON;
+        default:
+          return GeometryType::MULTIPOLYGON;
+      }
+    }
+
+    case GeographyKind::GEOGRAPHY_COLLECTION: {
+      const auto& collection = static_cast<const GeographyCollection&>(geog);
+      for (const auto& feature : collection.Features()) {
+        if (FeatureGeometryType(*feature) != GeometryType::GEOMETRY_TYPE_UNKNOWN) {
+          return GeometryType::GEOMETRYCOLLECTION;
+        }
+      }
+
+      return GeometryType::GEOMETRY_TYPE_UNKNOWN;
+    }
+
+    // Other subclasses (e.g., features of a geography store) are only
+    // defined by their shapes and are written as their rebuilt version
+    default:
+      return FeatureGeometryType(*s2_rebuild(geog, GlobalOptions()));
+  }
+}
+
+void GeoArrowWriter::InitSchema(struct ArrowSchema* schema) {
+  std::string metadata;
+  AppendMetadataInt32(&metadata, 2);
+  AppendMetadataPair(&metadata, "ARROW:extension:name", ExtensionName(geometry_type_));
+  if (tessellator_) {
+    AppendMetadataPair(&metadata, "ARROW:extension:metadata", "{}");
+  } else {
+    AppendMetadataPair(&metadata, "ARROW:extension:metadata",
+                       "{\"edges\":\"spherical\"}");
+  }
+
+  std::vector<std::string> names = LevelNames(geometry_type_);
+  for (int level = 0; level < n_levels_; level++) {
+    InitSchemaNode(schema, "+l", level == 0 ? "" : names[level - 1],
+                   level == 0 ? metadata : "", 1);
+    schema = schema->children[0];
+  }
+
+  InitSchemaNode(schema, "+w:2", n_levels_ == 0 ? "" : names.back(),
+                 n_levels_ == 0 ? metadata : "", 1);
+  InitSchemaNode(schema->children[0], "g", "xy", "", 0);
+}
+
+void GeoArrowWriter::Append(const Geography& geog) {
+  switch (geog.kind()) {
+    case GeographyKind::POINT:
+    case GeographyKind::POLYLINE:
+    case GeographyKind::POLYGON:
+    case GeographyKind::GEOGRAPHY_COLLECTION:
+      break;
+    default:
+      Append(*s2_rebuild(geog, GlobalOptions()));
+      return;
+  }
+
+  GeometryType feature_type = FeatureGeometryType(geog);
+  if (feature_type == GeometryType::GEOMETRY_TYPE_UNKNOWN) {
+    AppendEmpty();
+    return;
+  }
+
+  bool is_multi_of_feature_type =
+      feature_type < GeometryType::MULTIPOINT && (feature_type + 3) == geometry_type_;
+  if (feature_type != geometry_type_ && !is_multi_of_feature_type) {
+    std::stringstream err;
+    err << "Can't write feature with geometry type " << feature_type << " to "
+        << ExtensionName(geometry_type_) << " array";
+    throw Exception(err.str());
+  }
+
+  AppendValidity(true);
+
+  switch (geog.kind()) {
+    case GeographyKind::POINT:
+      AppendPoints(static_cast<const PointGeography&>(geog).Points());
+      break;
+    case GeographyKind::POLYLINE:
+      AppendPolylines(static_cast<const PolylineGeography&>(geog).Polylines());
+      break;
+    case GeographyKind::POLYGON:
+      AppendPolygon(*static_cast<const PolygonGeography&>(geog).Polygon());
+      break;
+    default:
+      break;
+  }
+}
+
+void GeoArrowWriter::AppendNull() {
+  AppendValidity(false);
+  if (geometry_type_ == GeometryType::POINT) {
+    coords_.push_back(std::numeric_limits<double>::quiet_NaN());
+    coords_.push_back(std::numeric_limits<double>::quiet_NaN());
+  } else {
+    offsets_[0].push_back(offsets_[0].back());
+  }
+}
+
+void GeoArrowWriter::AppendEmpty() {
+  AppendNull();
+  validity_.back() |= 1 << ((length_ - 1) % 8);
+  null_count_--;
+}
+
+void GeoArrowWriter::AppendValidity(bool valid) {
+  if ((length_ % 8) == 0) {
+    validity_.push_back(0);
+  }
+
+  if (valid) {
+    validity_.back() |= 1 << (length_ % 8);
+  } else {
+    null_count_++;
+  }
+
+  length_++;
+}
+
+void GeoArrowWriter::AppendPoints(const std::vector<S2Point>& points) {
+  if (geometry_type_ == GeometryType::POINT) {
+    AppendCoords(points.data(), 1, false);
+    return;
+  }
+
+  for (const S2Point& point : points) {
+    AppendCoords(&point, 1, false);
+  }
+  offsets_[0].push_back(num_coords());
+}
+
+void GeoArrowWriter::AppendPolylines(
+    const std::vector<std::unique_ptr<S2Polyline>>& polylines) {
+  int line_level = n_levels_ - 1;
+  for (const auto& polyline : polylines) {
+    if (polyline->num_vertices() > 0) {
+      AppendCoords(&polyline->vertex(0), polyline->num_vertices(), false);
+    }
+    offsets_[line_level].push_back(num_coords());
+  }
+
+  if (geometry_type_ == GeometryType::MULTILINESTRING) {
+    offsets_[0].push_back(CheckedOffset(offsets_[1].size() - 1));
+  }
+}
+
+void GeoArrowWriter::AppendPolygon(const S2Polygon& polygon) {
+  int ring_level = n_levels_ - 1;
+  for (int i = 0; i < polygon.num_loops(); i++) {
+    const S2Loop* shell = polygon.loop(i);
+    if ((shell->depth() % 2) != 0) {
+      continue;
+    }
+
+    AppendCoords(&shell->vertex(0), shell->num_vertices(), true);
+    offsets_[ring_level].push_back(num_coords());
+
+    // holes are written in the reverse order of their S2Loop vertices
+    for (int j = i + 1; j <= polygon.GetLastDescendant(i); j++) {
+      const S2Loop* hole = polygon.loop(j);
+      if (hole->depth() != (shell->depth() + 1)) {
+        continue;
+      }
+
+      loop_points_.clear();
+      for (int k = hole->num_vertices() - 1; k >= 0; k--) {
+        loop_points_.push_back(hole->vertex(k));
+      }
+
+      AppendCoords(loop_points_.data(), loop_points_.size(), true);
+      offsets_[ring_level].push_back(num_coords());
+    }
+
+    if (geometry_type_ == GeometryType::MULTIPOLYGON) {
+      offsets_[1].push_back(CheckedOffset(offsets_[2].size() - 1));
+    }
+  }
+
+  offsets_[0].push_back(CheckedOffset(offsets_[1].size() - 1));
+}
+
+void GeoArrowWriter::AppendCoords(const S2Point* points, int64_t n, bool close) {
+  if (n == 0) {
+    return;
+  }
+
+  projected_.clear();
+  if (!tessellator_ || (n == 1 && !close)) {
+    for (int64_t i = 0; i < n; i++) {
+      projected_.push_back(options_.projection()->Project(points[i]));
+    }
+
+    if (close) {
+      projected_.push_back(projected_[0]);
+    }
+  } else {
+    for (int64_t i = 1; i < n; i++) {
+      tessellator_->AppendProjected(points[i - 1], points[i], &projected_);
+    }
+
+    if (close) {
+      tessellator_->AppendProjected(points[n - 1], points[0], &projected_);
+      projected_.back() = projected_[0];
+    }
+  }
+
+  for (const R2Point& pt : projected_) {
+    coords_.push_back(pt.x());
+    coords_.push_back(pt.y());
+  }
+}
+
+int32_t GeoArrowWriter::num_coords() const {
+  return CheckedOffset(coords_.size() / 2);
+}
+
+void GeoArrowWriter::Finish(struct ArrowArray* array) {
+  ArrayPrivate* private_data = InitArrayNode(array, length_, 1);
+  array->null_count = null_count_;
+  if (null_count_ > 0) {
+    private_data->validity = std::move(validity_);
+    private_data->buffers.push_back(private_data->validity.data());
+  } else {
+    private_data->buffers.push_back(nullptr);
+  }
+
+  for (int level = 0; level < n_levels_; level++) {
+    private_data->offsets = std::move(offsets_[level]);
+    private_data->buffers.push_back(private_data->offsets.data());
+    SetArrayBuffers(array, private_data);
+
+    int64_t child_length = private_data->offsets.back();
+    array = array->children[0];
+    private_data = InitArrayNode(array, child_length, 1);
+    private_data->buffers.push_back(nullptr);
+  }
+
+  // fixed-size list of coordinates
+  SetArrayBuffers(array, private_data);
+
+  array = array->children[0];
+  private_data = InitArrayNode(array, coords_.size(), 0);
+  private_data->values = std::move(coords_);
+  private_data->buffers.push_back(nullptr);
+  private_data->buffers.push_back(private_data->values.data());
+  SetArrayBuffers(array, private_data);
+}
+
+}  // namespace util
+
+}  // namespace s2geography
@@ -0,0 +1,181 @@
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "constructor.h"
+#include "geoarrow-imports.h"
+#include "geography.h"
+#include "wkb.h"
+
+// Arrow C Data interface
+// https://arrow.apache.org/docs/format/CDataInterface.html
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+  // Array type description
+  const char* format;
+  const char* name;
+  const char* metadata;
+  int64_t flags;
+  int64_t n_children;
+  struct ArrowSchema** children;
+  struct ArrowSchema* dictionary;
+
+  // Release callback
+  void (*release)(struct ArrowSchema*);
+  // Opaque producer-specific data
+  void* private_data;
+};
+
+struct ArrowArray {
+  // Array data description
+  int64_t length;
+  int64_t null_count;
+  int64_t offset;
+  int64_t n_buffers;
+  int64_t n_children;
+  const void** buffers;
+  struct ArrowArray** children;
+  struct ArrowArray* dictionary;
+
+  // Release callback
+  void (*release)(struct ArrowArray*);
+  // Opaque producer-specific data
+  void* private_data;
+};
+
+#endif  // ARROW_C_DATA_INTERFACE
+
+namespace s2geography {
+
+namespace util {
+
+// Reads geoarrow-encoded arrays (geoarrow.point, geoarrow.linestring,
+// geoarrow.polygon, their multi- variants, or geoarrow.wkb) into a Handler
+// (usually a FeatureConstructor). Coordinates are read directly from the
+// array's buffers: for interleaved coordinates, each coordinate sequence
+// is passed to Handler::coords() without copying. The caller owns the
+// ArrowSchema and ArrowArray, which must outlive the reader. Readers are
+// cheap to create and one should be used per thread.
+class GeoArrowReader {
+ public:
+  explicit GeoArrowReader(Handler* handler)
+      : handler_(handler), wkb_reader_(handler) {}
+
+  // Parses the extension type from schema. Throws an Exception if schema
+  // does not describe a supported geoarrow extension type.
+  void Init(const struct ArrowSchema* schema);
+
+  // Sets the array from which features will be read. Throws an Exception
+  // if the array's layout does not match the schema passed to Init().
+  void SetArray(const struct ArrowArray* array);
+
+  // The edge type declared by the "edges" key of the schema's
+  // ARROW:extension:metadata. Edges are planar unless declared as spherical;
+  // a schema without extension metadata doesn't declare an edge type.
+  enum class Edges { UNSPECIFIED, PLANAR, SPHERICAL };
+
+  int64_t length() const { return length_; }
+  GeometryType geometry_type() const { return geometry_type_; }
+  Edges edges() const { return edges_; }
+  bool IsNull(int64_t i) const;
+
+  // Reads feature i, calling geom_start(), ring_start(), coords(),
+  // ring_end() and geom_end() on the handler. The caller is responsible
+  // for feature-level calls (e.g., feat_start()).
+  void ReadGeometry(int64_t i);
+
+ private:
+  Handler* handler_;
+  WKBReader wkb_reader_;
+
+  GeometryType geometry_type_;
+  Edges edges_;
+  bool wkb_;
+  bool large_wkb_;
+  bool interleaved_;
+  int32_t coord_size_;
+  int n_levels_;
+
+  int64_t length_;
+  int64_t offset_;
+  const uint8_t* validity_;
+  const int32_t* offsets_[3];
+  const double* interleaved_values_;
+  std::vector<const double*> separated_values_;
+  const uint8_t* wkb_data_;
+  const int32_t* wkb_offsets_;
+  const int64_t* large_wkb_offsets_;
+  std::vector<double> scratch_;
+
+  void SetCoordArray(const struct ArrowArray* array);
+  void ReadCoords(int64_t begin, int64_t end);
+  void ReadPoint(int64_t i);
+  void ReadLinestring(int level, int64_t i);
+  void ReadPolygon(int level, int64_t i);
+};
+
+// Writes Geography objects to an interleaved geoarrow array of a single
+// geometry type (e.g., geoarrow.polygon). Coordinates are projected
+// using the projection in options (tessellating edges if a tessellate
+// tolerance is set) and are appended to a single buffer as features are
+// written; buffers are moved (not copied) into the ArrowArray by Finish().
+class GeoArrowWriter {
+ public:
+  GeoArrowWriter(GeometryType geometry_type, const Constructor::Options& options);
+
+  // Returns the geometry type of the geoarrow array that geog can be
+  // written to (e.g., POLYGON or MULTIPOLYGON), or GEOMETRY_TYPE_UNKNOWN if
+  // geog is empty and can be written to any geometry type.
+  static GeometryType FeatureGeometryType(const Geography& geog);
+
+  // Populates schema with the geoarrow extension type of the output.
+  // Edges are marked as spherical unless a tessellate tolerance was set.
+  void InitSchema(struct ArrowSchema* schema);
+
+  // Append a feature or a null feature. Throws an Exception if the
+  // feature can't be represented by this writer's geometry type. Geography
+  // subclasses other than points, polylines, polygons, and collections
+  // (e.g., features of a geography store) are rebuilt with s2_rebuild().
+  void Append(const Geography& geog);
+  void AppendNull();
+
+  // Moves the accumulated buffers into array, which must be released.
+  // The writer may not be used after calling this method.
+  void Finish(struct ArrowArray* array);
+
+ private:
+  GeometryType geometry_type_;
+  Constructor::Options options_;
+  std::unique_ptr<S2EdgeTessellator> tessellator_;
+  int n_levels_;
+
+  int64_t length_;
+  int64_t null_count_;
+  std::vector<uint8_t> validity_;
+  std::vector<int32_t> offsets_[3];
+  std::vector<double> coords_;
+  std::vector<S2Point> loop_points_;
+  std::vector<R2Point> projected_;
+
+  void AppendValidity(bool valid);
+  void AppendPoints(const std::vector<S2Point>& points);
+  void AppendPolylines(const std::vector<std::unique_ptr<S2Polyline>>& polylines);
+  void AppendPolygon(const S2Polygon& polygon);
+  void AppendCoords(const S2Point* points, int64_t n, bool close);
+  void AppendEmpty();
+  int32_t num_coords() const;
+};
+
+}  // namespace util
+
+}  // namespace s2geography
@@ -1,6 +1,7 @@
 
 #include "geography.h"
 
+#include <s2/encoded_s2shape_index.h>
 #include <s2/mutable_s2shape_index.h>
 #include <s2/s2point_region.h>
 #include <s2/s2point_vector_shape.h>
@@ -23,7 +24,7 @@ using namespace s2geography;
 // s2/s2shapeutil_coding.cc.
 class S2ShapeWrapper : public S2Shape {
  public:
-  S2ShapeWrapper(S2Shape* shape) : shape_(shape) {}
+  S2ShapeWrapper(const S2Shape* shape) : shape_(shape) {}
   int num_edges() const { return shape_->num_edges(); }
   Edge edge(int edge_id) const { return shape_->edge(edge_id); }
   int dimension() const { return shape_->dimension(); }
@@ -40,7 +41,7 @@ class S2ShapeWrapper : public S2Shape {
   }
 
  private:
-  S2Shape* shape_;
+  const S2Shape* shape_;
 };
 
 // Just like the S2ShapeWrapper, the S2RegionWrapper helps reconcile the
@@ -69,10 +70,14 @@ class S2RegionWrapper : public S2Region {
   S2Region* region_;
 };
 
+std::unique_ptr<S2Shape> Geography::ShapeRef(int id) const {
+  return absl::make_unique<S2ShapeWrapper>(ShapeView(id));
+}
+
 void Geography::GetCellUnionBound(std::vector<S2CellId>* cell_ids) const {
   MutableS2ShapeIndex index;
   for (int i = 0; i < num_shapes(); i++) {
-    index.Add(Shape(i));
+    index.Add(ShapeRef(i));
   }
 
   MakeS2ShapeIndexRegion<MutableS2ShapeIndex>(&index).GetCellUnionBound(
@@ -106,6 +111,13 @@ void PointGeography::GetCellUnionBound(std::vector<S2CellId>* cell_ids) const {
 
 int PolylineGeography::num_shapes() const { return polylines_.size(); }
 
+void PolylineGeography::InitShapes() {
+  shapes_.reserve(polylines_.size());
+  for (const auto& polyline : polylines_) {
+    shapes_.emplace_back(polyline.get());
+  }
+}
+
 std::unique_ptr<S2Shape> PolylineGeography::Shape(int id) const {
   return absl::make_unique<S2Polyline::Shape>(polylines_[id].get());
 }
@@ -154,6 +166,18 @@ std::unique_ptr<S2Shape> GeographyCollection::Shape(int id) const {
   throw Exception("shape id out of bounds");
 }
 
+const S2Shape* GeographyCollection::ShapeView(int id) const {
+  int sum_shapes = 0;
+  for (size_t i = 0; i < features_.size(); i++) {
+    sum_shapes += num_shapes_[i];
+    if (id < sum_shapes) {
+      return features_[i]->ShapeView(id - sum_shapes + num_shapes_[i]);
+    }
+  }
+
+  throw Exception("shape id out of bounds");
+}
+
 std::unique_ptr<S2Region> GeographyCollection::Region() const {
   auto region = absl::make_unique<S2RegionUnion>();
   for (const auto& feature : features_) {
@@ -165,18 +189,63 @@ std::unique_ptr<S2Region> GeographyCollection::Region() const {
 }
 
 int ShapeIndexGeography::num_shapes() const {
-  return shape_index_.num_shape_ids();
+  return index_->num_shape_ids();
 }
 
 std::unique_ptr<S2Shape> ShapeIndexGeography::Shape(int id) const {
-  S2Shape* shape = shape_index_.shape(id);
+  S2Shape* shape = index_->shape(id);
   return std::unique_ptr<S2Shape>(new S2ShapeWrapper(shape));
 }
 
+void ShapeIndexGeography::EncodeIndex(Encoder* encoder) const {
+  if (encoded_ == nullptr) {
+    shape_index_.Encode(encoder);
+    return;
+  }
+
+  // An EncodedS2ShapeIndex can't be written in this format, so the shapes
+  // are indexed again (as they were before they were stored)
+  ShapeIndexGeography index(static_cast<const Geography&>(*encoded_));
+  index.EncodeIndex(encoder);
+}
+
+bool ShapeIndexGeography::DecodeIndex(Decoder* decoder, const Geography& geog) {
+  std::vector<std::unique_ptr<S2Shape>> shapes;
+  for (int i = 0; i < geog.num_shapes(); i++) {
+    shapes.push_back(geog.ShapeRef(i));
+  }
+
+  return shape_index_.Init(
+      decoder, s2shapeutil::VectorShapeFactory(std::move(shapes)));
+}
+
 std::unique_ptr<S2Region> ShapeIndexGeography::Region() const {
+  if (encoded_ != nullptr) {
+    return encoded_->Region();
+  }
+
   auto region =
       absl::make_unique<S2ShapeIndexRegion<MutableS2ShapeIndex>>(&shape_index_);
   // because Rtools for R 3.6 on Windows complains about a direct
   // return region
   return std::unique_ptr<S2Region>(region.release());
 }
+
+void EncodedShapeIndexGeography::Init(const char* data, size_t size) {
+  Decoder decoder(data, size);
+  if (!shape_index_.Init(&decoder,
+                         s2shapeutil::LazyDecodeShapeFactory(&decoder))) {
+    throw Exception("Failed to decode encoded shape index");
+  }
+}
+
+std::unique_ptr<S2Shape> EncodedShapeIndexGeography::Shape(int id) const {
+  S2Shape* shape = shape_index_.shape(id);
+  return std::unique_ptr<S2Shape>(new S2ShapeWrapper(shape));
+}
+
+std::unique_ptr<S2Region> EncodedShapeIndexGeography::Region() const {
+  auto region =
+      absl::make_unique<S2ShapeIndexRegion<EncodedS2ShapeIndex>>(&shape_index_);
+  return std::unique_ptr<S2Region>(region.release());
+}
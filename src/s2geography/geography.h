@@ -1,6 +1,7 @@
 
 #pragma once
 
+#include <s2/encoded_s2shape_index.h>
 #include <s2/s2polygon.h>
 #include <s2/s2polyline.h>
 #include <stdint.h>
@@ -15,6 +16,20 @@ class Exception : public std::runtime_error {
   Exception(std::string what) : std::runtime_error(what.c_str()) {}
 };
 
+// The concrete type of a Geography. Code that needs to handle each
+// subclass differently should switch on Geography::kind() (or use
+// geography_cast<>() or VisitGeography() below) rather than trying a
+// series of dynamic_cast<>()s, which is measurably slower when done
+// for millions of small features.
+enum class GeographyKind {
+  POINT = 1,
+  POLYLINE = 2,
+  POLYGON = 3,
+  GEOGRAPHY_COLLECTION = 4,
+  SHAPE_INDEX = 5,
+  ENCODED_SHAPE_INDEX = 6
+};
+
 // An Geography is an abstraction of S2 types that is designed to closely
 // match the scope of a GEOS Geometry. Its methods are limited to those needed
 // to implement C API functions. From an S2 perspective, an Geography is an
@@ -24,8 +39,11 @@ class Exception : public std::runtime_error {
 // future abstractions where this is not the case.
 class Geography {
  public:
+  explicit Geography(GeographyKind kind) : kind_(kind) {}
   virtual ~Geography() {}
 
+  GeographyKind kind() const { return kind_; }
+
   // Returns 0, 1, or 2 if all Shape()s that are returned will have
   // the same dimension (i.e., they are all points, all lines, or
   // all polygons).
@@ -34,9 +52,9 @@ class Geography {
       return -1;
     }
 
-    int dim = Shape(0)->dimension();
+    int dim = ShapeView(0)->dimension();
     for (int i = 1; i < num_shapes(); i++) {
-      if (dim != Shape(i)->dimension()) {
+      if (dim != ShapeView(i)->dimension()) {
         return -1;
       }
     }
@@ -53,6 +71,18 @@ class Geography {
   // the returned object.
   virtual std::unique_ptr<S2Shape> Shape(int id) const = 0;
 
+  // Returns the given S2Shape (where 0 <= id < num_shapes()) without
+  // allocating: the S2Shape is owned by the Geography and is valid for
+  // its lifetime. Prefer this to Shape() when the shape is only needed
+  // temporarily (e.g., to count its edges). Unlike Shape(), the returned
+  // object may not have the type tag of the equivalent S2 shape class.
+  virtual const S2Shape* ShapeView(int id) const = 0;
+
+  // Returns an owning wrapper around ShapeView(id) (e.g., for
+  // MutableS2ShapeIndex::Add()). This allocates a small object but, unlike
+  // Shape(), never copies the underlying data.
+  std::unique_ptr<S2Shape> ShapeRef(int id) const;
+
   // Returns an S2Region that represents the object. The caller retains
   // ownership of the S2Region but the data pointed to by the object
   // requires that the underlying Geography outlives the returned
@@ -64,19 +94,56 @@ class Geography {
   // return a small number of cells that can be used to compute a possible
   // intersection quickly.
   virtual void GetCellUnionBound(std::vector<S2CellId>* cell_ids) const;
+
+ private:
+  GeographyKind kind_;
+};
+
+// An S2Shape for a vector of points owned elsewhere (i.e., an
+// S2PointVectorShape that does not copy its points).
+class PointVectorShapeView : public S2Shape {
+ public:
+  explicit PointVectorShapeView(const std::vector<S2Point>* points)
+      : points_(points) {}
+
+  int num_edges() const { return static_cast<int>(points_->size()); }
+  Edge edge(int e) const { return Edge((*points_)[e], (*points_)[e]); }
+  int dimension() const { return 0; }
+  ReferencePoint GetReferencePoint() const {
+    return ReferencePoint::Contained(false);
+  }
+  int num_chains() const { return static_cast<int>(points_->size()); }
+  Chain chain(int i) const { return Chain(i, 1); }
+  Edge chain_edge(int i, int j) const {
+    return Edge((*points_)[i], (*points_)[i]);
+  }
+  ChainPosition chain_position(int e) const { return ChainPosition(e, 0); }
+
+ private:
+  const std::vector<S2Point>* points_;
 };
 
 // An Geography representing zero or more points using a std::vector<S2Point>
 // as the underlying representation.
 class PointGeography : public Geography {
  public:
-  PointGeography() {}
-  PointGeography(S2Point point) { points_.push_back(point); }
-  PointGeography(std::vector<S2Point> points) : points_(std::move(points)) {}
+  static constexpr GeographyKind kKind = GeographyKind::POINT;
+
+  PointGeography() : Geography(kKind), shape_(&points_) {}
+  PointGeography(S2Point point) : Geography(kKind), shape_(&points_) {
+    points_.push_back(point);
+  }
+  PointGeography(std::vector<S2Point> points)
+      : Geography(kKind), points_(std::move(points)), shape_(&points_) {}
+
+  // shape_ refers to points_ and can't be copied or moved with it
+  PointGeography(const PointGeography&) = delete;
+  PointGeography& operator=(const PointGeography&) = delete;
 
   int dimension() const { return 0; }
   int num_shapes() const { return 1; }
   std::unique_ptr<S2Shape> Shape(int id) const;
+  const S2Shape* ShapeView(int id) const { return &shape_; }
   std::unique_ptr<S2Region> Region() const;
   void GetCellUnionBound(std::vector<S2CellId>* cell_ids) const;
 
@@ -84,22 +151,29 @@ class PointGeography : public Geography {
 
  private:
   std::vector<S2Point> points_;
+  PointVectorShapeView shape_;
 };
 
 // An Geography representing zero or more polylines using the S2Polyline class
 // as the underlying representation.
 class PolylineGeography : public Geography {
  public:
-  PolylineGeography() {}
-  PolylineGeography(std::unique_ptr<S2Polyline> polyline) {
+  static constexpr GeographyKind kKind = GeographyKind::POLYLINE;
+
+  PolylineGeography() : Geography(kKind) {}
+  PolylineGeography(std::unique_ptr<S2Polyline> polyline) : Geography(kKind) {
     polylines_.push_back(std::move(polyline));
+    InitShapes();
   }
   PolylineGeography(std::vector<std::unique_ptr<S2Polyline>> polylines)
-      : polylines_(std::move(polylines)) {}
+      : Geography(kKind), polylines_(std::move(polylines)) {
+    InitShapes();
+  }
 
   int dimension() const { return 1; }
   int num_shapes() const;
   std::unique_ptr<S2Shape> Shape(int id) const;
+  const S2Shape* ShapeView(int id) const { return &shapes_[id]; }
   std::unique_ptr<S2Region> Region() const;
   void GetCellUnionBound(std::vector<S2CellId>* cell_ids) const;
 
@@ -109,6 +183,10 @@ class PolylineGeography : public Geography {
 
  private:
   std::vector<std::unique_ptr<S2Polyline>> polylines_;
+  // One (non-owning) shape per element of polylines_
+  std::vector<S2Polyline::Shape> shapes_;
+
+  void InitShapes();
 };
 
 // An Geography representing zero or more polygons using the S2Polygon class
@@ -117,13 +195,19 @@ class PolylineGeography : public Geography {
 // perspective).
 class PolygonGeography : public Geography {
  public:
-  PolygonGeography(): polygon_(new S2Polygon()) {}
+  static constexpr GeographyKind kKind = GeographyKind::POLYGON;
+
+  PolygonGeography()
+      : Geography(kKind), polygon_(new S2Polygon()), shape_(polygon_.get()) {}
   PolygonGeography(std::unique_ptr<S2Polygon> polygon)
-      : polygon_(std::move(polygon)) {}
+      : Geography(kKind),
+        polygon_(std::move(polygon)),
+        shape_(polygon_.get()) {}
 
   int dimension() const { return 2; }
   int num_shapes() const { return 1; }
   std::unique_ptr<S2Shape> Shape(int id) const;
+  const S2Shape* ShapeView(int id) const { return &shape_; }
   std::unique_ptr<S2Region> Region() const;
   void GetCellUnionBound(std::vector<S2CellId>* cell_ids) const;
 
@@ -131,16 +215,21 @@ class PolygonGeography : public Geography {
 
  private:
   std::unique_ptr<S2Polygon> polygon_;
+  // Initialized with the loops of polygon_ when it is constructed (which
+  // is why polygon_ must not be modified after this point)
+  S2Polygon::Shape shape_;
 };
 
 // An Geography wrapping zero or more Geography objects. These objects
 // can be used to represent a simple features GEOMETRYCOLLECTION.
 class GeographyCollection : public Geography {
  public:
-  GeographyCollection() : total_shapes_(0) {}
+  static constexpr GeographyKind kKind = GeographyKind::GEOGRAPHY_COLLECTION;
+
+  GeographyCollection() : Geography(kKind), total_shapes_(0) {}
 
   GeographyCollection(std::vector<std::unique_ptr<Geography>> features)
-      : features_(std::move(features)), total_shapes_(0) {
+      : Geography(kKind), features_(std::move(features)), total_shapes_(0) {
     for (const auto& feature : features_) {
       num_shapes_.push_back(feature->num_shapes());
       total_shapes_ += feature->num_shapes();
@@ -149,6 +238,7 @@ class GeographyCollection : public Geography {
 
   int num_shapes() const;
   std::unique_ptr<S2Shape> Shape(int id) const;
+  const S2Shape* ShapeView(int id) const;
   std::unique_ptr<S2Region> Region() const;
 
   const std::vector<std::unique_ptr<Geography>>& Features() const {
@@ -161,20 +251,59 @@ class GeographyCollection : public Geography {
   int total_shapes_;
 };
 
+// An Geography backed by an EncodedS2ShapeIndex whose encoded bytes are
+// owned elsewhere (e.g., a memory-mapped file). Only the index header is
+// read by Init(): shapes and index cells are decoded lazily when they are
+// first accessed, so a large collection of these objects uses little
+// memory until they are used. The encoded bytes must outlive this object.
+class EncodedShapeIndexGeography : public Geography {
+ public:
+  static constexpr GeographyKind kKind = GeographyKind::ENCODED_SHAPE_INDEX;
+
+  EncodedShapeIndexGeography() : Geography(kKind) {}
+
+  // Initializes the index from data written by util::EncodeShapeIndex().
+  // Throws an Exception if data can't be decoded.
+  void Init(const char* data, size_t size);
+
+  int num_shapes() const { return shape_index_.num_shape_ids(); }
+  std::unique_ptr<S2Shape> Shape(int id) const;
+  const S2Shape* ShapeView(int id) const { return shape_index_.shape(id); }
+  std::unique_ptr<S2Region> Region() const;
+
+  const EncodedS2ShapeIndex& ShapeIndex() const { return shape_index_; }
+
+ private:
+  EncodedS2ShapeIndex shape_index_;
+};
+
 // An Geography with a MutableS2ShapeIndex as the underlying data.
 // These are used as inputs for operations that are implemented in S2
 // using the S2ShapeIndex (e.g., boolean operations). If an Geography
 // instance will be used repeatedly, it will be faster to construct
 // one ShapeIndexGeography and use it repeatedly. This class does not
 // own any Geography objects that are added do it and thus is only
-// valid for the scope of those objects.
+// valid for the scope of those objects. A ShapeIndexGeography can also
+// refer to the (already built) index of an EncodedShapeIndexGeography, in
+// which case ShapeIndex() is that index and Add() must not be called.
 class ShapeIndexGeography : public Geography {
  public:
+  static constexpr GeographyKind kKind = GeographyKind::SHAPE_INDEX;
+
   ShapeIndexGeography(
       MutableS2ShapeIndex::Options options = MutableS2ShapeIndex::Options())
-      : shape_index_(options) {}
+      : Geography(kKind),
+        shape_index_(options),
+        index_(&shape_index_),
+        encoded_(nullptr) {}
+
+  explicit ShapeIndexGeography(const Geography& geog)
+      : Geography(kKind), index_(&shape_index_), encoded_(nullptr) {
+    Add(geog);
+  }
 
-  explicit ShapeIndexGeography(const Geography& geog) { Add(geog); }
+  explicit ShapeIndexGeography(const EncodedShapeIndexGeography& geog)
+      : Geography(kKind), index_(&geog.ShapeIndex()), encoded_(&geog) {}
 
   // Add a Geography to the index, returning the last shape_id
   // that was added to the index or -1 if no shapes were added
@@ -182,19 +311,66 @@ class ShapeIndexGeography : public Geography {
   int Add(const Geography& geog) {
     int id = -1;
     for (int i = 0; i < geog.num_shapes(); i++) {
-      id = shape_index_.Add(geog.Shape(i));
+      id = shape_index_.Add(geog.ShapeRef(i));
     }
     return id;
   }
 
   int num_shapes() const;
   std::unique_ptr<S2Shape> Shape(int id) const;
+  const S2Shape* ShapeView(int id) const { return index_->shape(id); }
   std::unique_ptr<S2Region> Region() const;
 
-  const MutableS2ShapeIndex& ShapeIndex() const { return shape_index_; }
+  const S2ShapeIndex& ShapeIndex() const { return *index_; }
+
+  // Encodes the index structure (but not the shapes it contains) using
+  // MutableS2ShapeIndex::Encode(). DecodeIndex() restores an index encoded
+  // this way without rebuilding it, given the Geography whose shapes were
+  // originally added to the index. Returns false if decoding failed.
+  void EncodeIndex(Encoder* encoder) const;
+  bool DecodeIndex(Decoder* decoder, const Geography& geog);
 
  private:
   MutableS2ShapeIndex shape_index_;
+  const S2ShapeIndex* index_;
+  const EncodedShapeIndexGeography* encoded_;
 };
 
+// Returns geog as a T (e.g., PolygonGeography) if geog->kind() is
+// T::kKind or nullptr otherwise. This is a cheaper replacement for
+// dynamic_cast<const T*>(geog) when T is one of the classes above.
+template <typename T>
+const T* geography_cast(const Geography* geog) {
+  return geog->kind() == T::kKind ? static_cast<const T*>(geog) : nullptr;
+}
+
+template <typename T>
+T* geography_cast(Geography* geog) {
+  return geog->kind() == T::kKind ? static_cast<T*>(geog) : nullptr;
+}
+
+// Calls visitor with geog cast to its concrete class based on geog.kind().
+// The visitor is usually an overload set whose operator() accepts each
+// class that needs special handling and a const Geography& as a fallback;
+// each overload must return the same type.
+template <typename Visitor>
+decltype(auto) VisitGeography(const Geography& geog, Visitor&& visitor) {
+  switch (geog.kind()) {
+    case GeographyKind::POINT:
+      return visitor(static_cast<const PointGeography&>(geog));
+    case GeographyKind::POLYLINE:
+      return visitor(static_cast<const PolylineGeography&>(geog));
+    case GeographyKind::POLYGON:
+      return visitor(static_cast<const PolygonGeography&>(geog));
+    case GeographyKind::GEOGRAPHY_COLLECTION:
+      return visitor(static_cast<const GeographyCollection&>(geog));
+    case GeographyKind::SHAPE_INDEX:
+      return visitor(static_cast<const ShapeIndexGeography&>(geog));
+    case GeographyKind::ENCODED_SHAPE_INDEX:
+      return visitor(static_cast<const EncodedShapeIndexGeography&>(geog));
+    default:
+      return visitor(geog);
+  }
+}
+
 }  // namespace s2geography
@@ -21,7 +21,7 @@ class GeographyIndex {
   void Add(const Geography& geog, int value) {
     values_.reserve(values_.size() + geog.num_shapes());
     for (int i = 0; i < geog.num_shapes(); i++) {
-      int new_shape_id = index_.Add(geog.Shape(i));
+      int new_shape_id = index_.Add(geog.ShapeRef(i));
       values_.resize(new_shape_id + 1);
       values_[new_shape_id] = value;
     }
@@ -1,6 +1,11 @@
 
 #include "linear-referencing.h"
 
+#include <s2/s2closest_edge_query.h>
+#include <s2/s2edge_distances.h>
+
+#include <algorithm>
+
 #include "accessors.h"
 #include "build.h"
 #include "geography.h"
@@ -18,25 +23,43 @@ double s2_project_normalized(const PolylineGeography& geog1,
   return geog1.Polylines()[0]->UnInterpolate(point_on_line, next_vertex);
 }
 
-double s2_project_normalized(const Geography& geog1,
-                             const Geography& geog2) {
-  if (geog1.dimension() != 1 || geog2.dimension() != 0) {
-    return NAN;
-  }
+namespace {
 
+// Returns the point in geog or (0, 0, 0) if geog is not a single point
+S2Point SinglePoint(const Geography& geog) {
   S2Point point;
-  for (int i = 0; i < geog2.num_shapes(); i++) {
-    auto shape = geog2.Shape(i);
+  if (geog.dimension() != 0) {
+    return point;
+  }
+
+  for (int i = 0; i < geog.num_shapes(); i++) {
+    const S2Shape* shape = geog.ShapeView(i);
     for (int j = 0; j < shape->num_edges(); j++) {
       if (point.Norm2() != 0) {
-        return NAN;
+        return S2Point();
       } else {
         point = shape->edge(j).v0;
       }
     }
   }
 
-  auto geog1_poly_ptr = dynamic_cast<const PolylineGeography*>(&geog1);
+  return point;
+}
+
+}  // namespace
+
+double s2_project_normalized(const Geography& geog1,
+                             const Geography& geog2) {
+  if (geog1.dimension() != 1) {
+    return NAN;
+  }
+
+  S2Point point = SinglePoint(geog2);
+  if (point.Norm2() == 0) {
+    return NAN;
+  }
+
+  auto geog1_poly_ptr = geography_cast<PolylineGeography>(&geog1);
   if (geog1_poly_ptr != nullptr) {
     return s2_project_normalized(*geog1_poly_ptr, point);
   }
@@ -66,7 +89,7 @@ S2Point s2_interpolate_normalized(const Geography& geog,
     throw Exception("`geog` must be a single polyline");
   }
 
-  auto geog_poly_ptr = dynamic_cast<const PolylineGeography*>(&geog);
+  auto geog_poly_ptr = geography_cast<PolylineGeography>(&geog);
   if (geog_poly_ptr != nullptr) {
     return s2_interpolate_normalized(*geog_poly_ptr, distance_norm);
   }
@@ -75,4 +98,135 @@ S2Point s2_interpolate_normalized(const Geography& geog,
   return s2_interpolate_normalized(*geog_poly, distance_norm);
 }
 
+bool LinearReference::Init(const Geography& geog) {
+  if (geog.dimension() != 1) {
+    return false;
+  }
+
+  auto geog_poly_ptr = geography_cast<PolylineGeography>(&geog);
+  std::unique_ptr<Geography> geog_rebuilt;
+  if (geog_poly_ptr == nullptr) {
+    geog_rebuilt = s2_rebuild(geog, GlobalOptions());
+    geog_poly_ptr = geography_cast<PolylineGeography>(geog_rebuilt.get());
+  }
+
+  if (geog_poly_ptr == nullptr || geog_poly_ptr->Polylines().size() != 1) {
+    return false;
+  }
+
+  Init(*geog_poly_ptr->Polylines()[0]);
+  return true;
+}
+
+void LinearReference::Init(const S2Polyline& polyline) {
+  polyline_.set_s2debug_override(S2Debug::DISABLE);
+  polyline_.Init(polyline.vertices_span());
+  index_.reset();
+
+  cumulative_.resize(polyline_.num_vertices());
+  double length = 0;
+  for (int i = 0; i < polyline_.num_vertices(); i++) {
+    if (i > 0) {
+      length += S1Angle(polyline_.vertex(i - 1), polyline_.vertex(i)).radians();
+    }
+    cumulative_[i] = length;
+  }
+}
+
+void LinearReference::BuildIndex() {
+  index_ = absl::make_unique<MutableS2ShapeIndex>();
+  index_->Add(absl::make_unique<S2Polyline::Shape>(&polyline_));
+  index_->ForceBuild();
+}
+
+S2Point LinearReference::Interpolate(double distance_norm) const {
+  if (is_empty()) {
+    return S2Point();
+  } else if (distance_norm <= 0) {
+    return polyline_.vertex(0);
+  }
+
+  // the first vertex that is further along the line than the target
+  double target = distance_norm * length();
+  auto next = std::upper_bound(cumulative_.begin(), cumulative_.end(), target);
+  if (next == cumulative_.end()) {
+    return polyline_.vertex(polyline_.num_vertices() - 1);
+  }
+
+  int i = next - cumulative_.begin();
+  return S2::GetPointOnLine(polyline_.vertex(i - 1), polyline_.vertex(i),
+                            S1Angle::Radians(target - cumulative_[i - 1]));
+}
+
+double LinearReference::Project(const S2Point& point) const {
+  if (polyline_.num_vertices() < 2) {
+    return 0;
+  }
+
+  int edge_id = 0;
+  if (index_) {
+    S2ClosestEdgeQuery query(index_.get());
+    S2ClosestEdgeQuery::PointTarget target(point);
+    edge_id = query.FindClosestEdge(&target).edge_id();
+  } else {
+    S1ChordAngle min_distance = S1ChordAngle::Infinity();
+    for (int i = 1; i < polyline_.num_vertices(); i++) {
+      if (S2::UpdateMinDistance(point, polyline_.vertex(i - 1),
+                                polyline_.vertex(i), &min_distance)) {
+        edge_id = i - 1;
+      }
+    }
+  }
+
+  S2Point point_on_line = S2::Project(point, polyline_.vertex(edge_id),
+                                      polyline_.vertex(edge_id + 1));
+  double length_to_point =
+      cumulative_[edge_id] +
+      S1Angle(polyline_.vertex(edge_id), point_on_line).radians();
+
+  // as for S2Polyline::UnInterpolate(), the ratio can be greater than 1.0
+  // due to rounding errors
+  return std::min(1.0, length_to_point / length());
+}
+
+double LinearReference::Project(const Geography& geog) const {
+  S2Point point = SinglePoint(geog);
+  if (point.Norm2() == 0) {
+    return NAN;
+  }
+
+  return Project(point);
+}
+
+std::vector<S2Point> LinearReference::Substring(double start_norm,
+                                                double end_norm) const {
+  std::vector<S2Point> vertices;
+  if (is_empty()) {
+    return vertices;
+  } else if (start_norm > end_norm) {
+    throw Exception("`start` must be less than or equal to `end`");
+  }
+
+  start_norm = std::max(0.0, std::min(1.0, start_norm));
+  end_norm = std::max(0.0, std::min(1.0, end_norm));
+  double end = end_norm * length();
+
+  vertices.push_back(Interpolate(start_norm));
+  auto next = std::upper_bound(cumulative_.begin(), cumulative_.end(),
+                               start_norm * length());
+  for (; next != cumulative_.end() && *next < end; ++next) {
+    S2Point vertex = polyline_.vertex(next - cumulative_.begin());
+    if (vertex != vertices.back()) {
+      vertices.push_back(vertex);
+    }
+  }
+
+  S2Point last = Interpolate(end_norm);
+  if (last != vertices.back()) {
+    vertices.push_back(last);
+  }
+
+  return vertices;
+}
+
 }  // namespace s2geography
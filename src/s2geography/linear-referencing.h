@@ -1,6 +1,9 @@
 
 #pragma once
 
+#include <s2/mutable_s2shape_index.h>
+#include <s2/s2polyline.h>
+
 #include "geography.h"
 
 namespace s2geography {
@@ -10,4 +13,47 @@ double s2_project_normalized(const Geography& geog1,
 S2Point s2_interpolate_normalized(const Geography& geog,
                                   double distance_norm);
 
+// A polyline prepared for repeated linear referencing. The cumulative
+// length at each vertex is computed once so that interpolation is a
+// binary search rather than a walk from the start of the line. Projection
+// walks every edge unless BuildIndex() was called, in which case an
+// S2ClosestEdgeQuery is used. Once initialized (and indexed), all queries
+// are const and may be called from multiple threads.
+class LinearReference {
+ public:
+  LinearReference() = default;
+
+  // Initializes from a geography containing a single polyline, rebuilding
+  // it if it is not a PolylineGeography. Returns false if geog is not a
+  // single polyline.
+  bool Init(const Geography& geog);
+  void Init(const S2Polyline& polyline);
+  void BuildIndex();
+
+  bool is_empty() const { return polyline_.num_vertices() == 0; }
+  const S2Polyline& polyline() const { return polyline_; }
+
+  // The length of the polyline in radians
+  double length() const {
+    return cumulative_.empty() ? 0 : cumulative_.back();
+  }
+
+  S2Point Interpolate(double distance_norm) const;
+  double Project(const S2Point& point) const;
+
+  // Projects a geography containing exactly one point, returning NaN
+  // otherwise
+  double Project(const Geography& geog) const;
+
+  // The vertices between two normalized distances along the line
+  // (which are clamped to [0, 1]). start_norm must not be greater than
+  // end_norm; if both refer to the same point, one vertex is returned.
+  std::vector<S2Point> Substring(double start_norm, double end_norm) const;
+
+ private:
+  S2Polyline polyline_;
+  std::vector<double> cumulative_;
+  std::unique_ptr<MutableS2ShapeIndex> index_;
+};
+
 }  // namespace s2geography
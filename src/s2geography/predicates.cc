@@ -4,6 +4,7 @@
 #include <s2/s2boolean_operation.h>
 #include <s2/s2edge_tessellator.h>
 #include <s2/s2lax_loop_shape.h>
+#include <s2/s2latlng_rect_bounder.h>
 
 #include "accessors.h"
 
@@ -34,26 +35,85 @@ bool s2_contains(const ShapeIndexGeography& geog1,
   }
 }
 
-// Note that 'touches' can be implemeted using:
-//
-// S2BooleanOperation::Options closedOptions = options;
-// closedOptions.set_polygon_model(S2BooleanOperation::PolygonModel::CLOSED);
-// closedOptions.set_polyline_model(S2BooleanOperation::PolylineModel::CLOSED);
-// S2BooleanOperation::Options openOptions = options;
-// openOptions.set_polygon_model(S2BooleanOperation::PolygonModel::OPEN);
-// openOptions.set_polyline_model(S2BooleanOperation::PolylineModel::OPEN);
-// s2_intersects(geog1, geog2, closed_options) &&
-//   !s2_intersects(geog1, geog2, open_options);
-//
-// ...it isn't implemented here because the options creation should be done
-// outside of any loop.
+bool s2_touches(const ShapeIndexGeography& geog1,
+                const ShapeIndexGeography& geog2,
+                const S2BooleanOperation::Options& options) {
+  RelationEvaluator evaluator(options);
+  return evaluator.Evaluate(geog1, geog2, RelationEvaluator::kTouches) != 0;
+}
+
+RelationEvaluator::RelationEvaluator(
+    const S2BooleanOperation::Options& options)
+    : closed_options_(options), open_options_(options) {
+  closed_options_.set_polygon_model(S2BooleanOperation::PolygonModel::CLOSED);
+  closed_options_.set_polyline_model(
+      S2BooleanOperation::PolylineModel::CLOSED);
+  open_options_.set_polygon_model(S2BooleanOperation::PolygonModel::OPEN);
+  open_options_.set_polyline_model(S2BooleanOperation::PolylineModel::OPEN);
+}
+
+uint32_t RelationEvaluator::Evaluate(const ShapeIndexGeography& geog1,
+                                     const ShapeIndexGeography& geog2,
+                                     uint32_t relations) const {
+  const S2ShapeIndex& index1 = geog1.ShapeIndex();
+  const S2ShapeIndex& index2 = geog2.ShapeIndex();
+  bool empty1 = s2_is_empty(geog1);
+  bool empty2 = s2_is_empty(geog2);
+
+  // Empty geographies don't intersect, cover, or touch anything, but two
+  // empty geographies are equal
+  if (empty1 || empty2) {
+    return (empty1 && empty2) ? (relations & kEquals) : 0;
+  }
+
+  // Every other relation implies that the closures intersect, so this one
+  // pass is all that is needed for disjoint pairs
+  if (!S2BooleanOperation::Intersects(index1, index2, closed_options_)) {
+    return 0;
+  }
+
+  uint32_t result = relations & kIntersects;
+
+  if (relations & (kIntersectsOpen | kTouches)) {
+    if (S2BooleanOperation::Intersects(index1, index2, open_options_)) {
+      result |= relations & kIntersectsOpen;
+    } else {
+      result |= relations & kTouches;
+    }
+  }
+
+  // Equality is derived from mutual coverage, so covered_by only needs to be
+  // computed for equality if covers is true
+  bool covers = false;
+  if (relations & (kCovers | kEquals)) {
+    covers = S2BooleanOperation::Contains(index1, index2, closed_options_);
+    if (covers) {
+      result |= relations & kCovers;
+    }
+  }
+
+  if ((relations & kCoveredBy) || ((relations & kEquals) && covers)) {
+    if (S2BooleanOperation::Contains(index2, index1, closed_options_)) {
+      result |= relations & kCoveredBy;
+      if (covers) {
+        result |= relations & kEquals;
+      }
+    }
+  }
+
+  return result;
+}
 
 bool s2_intersects_box(const ShapeIndexGeography& geog1,
                        const S2LatLngRect& rect,
                        const S2BooleanOperation::Options& options,
                        double tolerance) {
+  PreparedBox box(rect, tolerance);
+  return box.Intersects(geog1, options);
+}
+
+PreparedBox::PreparedBox(const S2LatLngRect& rect, double tolerance) {
   // 99% of this is making a S2Loop out of a S2LatLngRect
-  // This should probably be implemented elsewhere
   S2::PlateCarreeProjection projection(180);
   S2EdgeTessellator tessellator(&projection, S1Angle::Degrees(tolerance));
   std::vector<S2Point> vertices;
@@ -73,11 +133,47 @@ bool s2_intersects_box(const ShapeIndexGeography& geog1,
 
   vertices.pop_back();
 
+  // The tessellated edges stray from the parallels that bound the box by up
+  // to the tolerance, so a bound that is inside the box shrunk by (a bit more
+  // than) the tolerance is inside the loop and a bound that is disjoint from
+  // the bound of the loop's edges is outside it. This doesn't hold if the
+  // box touches a pole or spans 180 degrees of longitude or more (the
+  // tessellated edges always take the shorter way around), in which case
+  // every geography is checked using a boolean operation.
+  use_bounds_ = rect.lng().GetLength() < M_PI &&
+                rect.lat_lo().degrees() > -90 && rect.lat_hi().degrees() < 90;
+  if (use_bounds_) {
+    S1Angle margin = S1Angle::Degrees(tolerance * 1.5) + S1Angle::Radians(1e-9);
+    inner_ = rect.ExpandedByDistance(-margin);
+
+    S2LatLngRectBounder bounder;
+    for (const S2Point& vertex : vertices) {
+      bounder.AddPoint(vertex);
+    }
+    bounder.AddPoint(vertices[0]);
+    outer_ = bounder.GetBound();
+  }
+
   auto loop = absl::make_unique<S2LaxLoopShape>(std::move(vertices));
-  MutableS2ShapeIndex index;
-  index.Add(std::move(loop));
+  index_.Add(std::move(loop));
+  index_.ForceBuild();
+}
+
+int PreparedBox::IntersectsBound(const S2LatLngRect& bound) const {
+  if (!use_bounds_) {
+    return -1;
+  } else if (bound.is_empty() || !outer_.Intersects(bound)) {
+    return 0;
+  } else if (!inner_.is_empty() && inner_.Contains(bound)) {
+    return 1;
+  } else {
+    return -1;
+  }
+}
 
-  return S2BooleanOperation::Intersects(geog1.ShapeIndex(), index, options);
+bool PreparedBox::Intersects(const ShapeIndexGeography& geog,
+                             const S2BooleanOperation::Options& options) const {
+  return S2BooleanOperation::Intersects(geog.ShapeIndex(), index_, options);
 }
 
 }  // namespace s2geography
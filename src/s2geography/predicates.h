@@ -23,9 +23,66 @@ bool s2_touches(const ShapeIndexGeography& geog1,
                 const ShapeIndexGeography& geog2,
                 const S2BooleanOperation::Options& options);
 
+// Evaluates several relations between the same pair of geographies,
+// sharing work between them where possible. Relations are evaluated using
+// a closed model (i.e., boundaries are included) regardless of the model in
+// options except for kIntersectsOpen, which uses an open model (i.e., only
+// interiors are included). A disjoint pair (the common case) is detected
+// in one pass; relations are only computed when they were requested
+// (or are needed to derive a requested relation) and can't be implied from
+// relations that have already been computed.
+class RelationEvaluator {
+ public:
+  enum Relation : uint32_t {
+    kIntersects = 1 << 0,
+    kIntersectsOpen = 1 << 1,
+    kCovers = 1 << 2,
+    kCoveredBy = 1 << 3,
+    kTouches = 1 << 4,
+    kEquals = 1 << 5,
+    kAll = (1 << 6) - 1
+  };
+
+  RelationEvaluator(const S2BooleanOperation::Options& options);
+
+  // Returns a bitmask of the relations (among those requested) that
+  // are true
+  uint32_t Evaluate(const ShapeIndexGeography& geog1,
+                    const ShapeIndexGeography& geog2,
+                    uint32_t relations = kAll) const;
+
+ private:
+  S2BooleanOperation::Options closed_options_;
+  S2BooleanOperation::Options open_options_;
+};
+
 bool s2_intersects_box(const ShapeIndexGeography& geog1,
                        const S2LatLngRect& rect,
                        const S2BooleanOperation::Options& options,
                        double tolerance);
 
+// A longitude/latitude box prepared for testing intersection with many
+// geographies. The edges of the box are tessellated (to within tolerance
+// degrees) and indexed once. Given the rectangle bound of a geography,
+// geographies that are well inside or clearly outside the box are resolved
+// without a boolean operation (or an index of the geography).
+class PreparedBox {
+ public:
+  PreparedBox(const S2LatLngRect& rect, double tolerance);
+
+  // Returns 1 if a geography with this bound definitely intersects the
+  // box, 0 if it definitely does not, and -1 if Intersects() must be used
+  // to decide
+  int IntersectsBound(const S2LatLngRect& bound) const;
+
+  bool Intersects(const ShapeIndexGeography& geog,
+                  const S2BooleanOperation::Options& options) const;
+
+ private:
+  MutableS2ShapeIndex index_;
+  bool use_bounds_;
+  S2LatLngRect inner_;
+  S2LatLngRect outer_;
+};
+
 }  // namespace s2geography
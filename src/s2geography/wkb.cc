@@ -0,0 +1,191 @@
+
+#include "wkb.h"
+
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+namespace s2geography {
+
+namespace util {
+
+namespace {
+
+constexpr uint32_t kEWKBHasZ = 0x80000000;
+constexpr uint32_t kEWKBHasM = 0x40000000;
+constexpr uint32_t kEWKBHasSRID = 0x20000000;
+
+bool IsLittleEndian() {
+  uint16_t value = 1;
+  uint8_t first_byte;
+  memcpy(&first_byte, &value, 1);
+  return first_byte == 1;
+}
+
+uint32_t ByteSwap32(uint32_t value) {
+  return ((value & 0x000000ff) << 24) | ((value & 0x0000ff00) << 8) |
+         ((value & 0x00ff0000) >> 8) | ((value & 0xff000000) >> 24);
+}
+
+uint64_t ByteSwap64(uint64_t value) {
+  return (static_cast<uint64_t>(ByteSwap32(value & 0xffffffff)) << 32) |
+         ByteSwap32(value >> 32);
+}
+
+}  // namespace
+
+void WKBReader::ReadGeometry(const uint8_t* data, int64_t size) {
+  data_ = data;
+  size_ = size;
+  offset_ = 0;
+  ReadGeometry();
+}
+
+void WKBReader::ReadGeometry() {
+  uint8_t endian = ReadUInt8();
+  if (endian > 1) {
+    std::stringstream err;
+    err << "Unexpected byte order value in WKB: " << static_cast<int>(endian);
+    throw Exception(err.str());
+  }
+
+  // 0x01 is little endian
+  swap_endian_ = (endian == 1) != IsLittleEndian();
+
+  uint32_t geometry_type = ReadUInt32();
+  bool has_z = geometry_type & kEWKBHasZ;
+  bool has_m = geometry_type & kEWKBHasM;
+  bool has_srid = geometry_type & kEWKBHasSRID;
+  geometry_type &= 0x0000ffff;
+
+  if (geometry_type >= 3000) {
+    has_z = true;
+    has_m = true;
+    geometry_type -= 3000;
+  } else if (geometry_type >= 2000) {
+    has_m = true;
+    geometry_type -= 2000;
+  } else if (geometry_type >= 1000) {
+    has_z = true;
+    geometry_type -= 1000;
+  }
+
+  if (has_srid) {
+    ReadUInt32();
+  }
+
+  int32_t coord_size = 2 + has_z + has_m;
+
+  switch (geometry_type) {
+    case GeometryType::POINT: {
+      ReadCoordinates(1, coord_size);
+      bool empty = true;
+      for (double value : coords_) {
+        empty = empty && std::isnan(value);
+      }
+
+      handler_->geom_start(GeometryType::POINT, empty ? 0 : 1);
+      if (!empty) {
+        handler_->coords(coords_.data(), 1, coord_size);
+      }
+      handler_->geom_end();
+      break;
+    }
+
+    case GeometryType::LINESTRING: {
+      uint32_t n = ReadUInt32();
+      handler_->geom_start(GeometryType::LINESTRING, n);
+      ReadCoordinates(n, coord_size);
+      if (n > 0) {
+        handler_->coords(coords_.data(), n, coord_size);
+      }
+      handler_->geom_end();
+      break;
+    }
+
+    case GeometryType::POLYGON: {
+      uint32_t n_rings = ReadUInt32();
+      handler_->geom_start(GeometryType::POLYGON, n_rings);
+      for (uint32_t i = 0; i < n_rings; i++) {
+        uint32_t n = ReadUInt32();
+        handler_->ring_start(n);
+        ReadCoordinates(n, coord_size);
+        if (n > 0) {
+          handler_->coords(coords_.data(), n, coord_size);
+        }
+        handler_->ring_end();
+      }
+      handler_->geom_end();
+      break;
+    }
+
+    case GeometryType::MULTIPOINT:
+    case GeometryType::MULTILINESTRING:
+    case GeometryType::MULTIPOLYGON:
+    case GeometryType::GEOMETRYCOLLECTION: {
+      uint32_t n_parts = ReadUInt32();
+      handler_->geom_start(static_cast<GeometryType>(geometry_type), n_parts);
+      for (uint32_t i = 0; i < n_parts; i++) {
+        ReadGeometry();
+      }
+      handler_->geom_end();
+      break;
+    }
+
+    default: {
+      std::stringstream err;
+      err << "Unsupported geometry type in WKB: " << geometry_type;
+      throw Exception(err.str());
+    }
+  }
+}
+
+void WKBReader::ReadCoordinates(uint32_t n, int32_t coord_size) {
+  int64_t n_values = static_cast<int64_t>(n) * coord_size;
+  CheckAvailable(n_values * sizeof(double));
+
+  coords_.resize(n_values);
+  memcpy(coords_.data(), data_ + offset_, n_values * sizeof(double));
+  offset_ += n_values * sizeof(double);
+
+  if (swap_endian_) {
+    uint64_t value;
+    for (double& coord : coords_) {
+      memcpy(&value, &coord, sizeof(double));
+      value = ByteSwap64(value);
+      memcpy(&coord, &value, sizeof(double));
+    }
+  }
+}
+
+uint8_t WKBReader::ReadUInt8() {
+  CheckAvailable(1);
+  return data_[offset_++];
+}
+
+uint32_t WKBReader::ReadUInt32() {
+  CheckAvailable(sizeof(uint32_t));
+  uint32_t value;
+  memcpy(&value, data_ + offset_, sizeof(uint32_t));
+  offset_ += sizeof(uint32_t);
+
+  if (swap_endian_) {
+    return ByteSwap32(value);
+  } else {
+    return value;
+  }
+}
+
+void WKBReader::CheckAvailable(int64_t n) {
+  if ((offset_ + n) > size_) {
+    std::stringstream err;
+    err << "Unexpected end of WKB buffer at byte " << offset_ << " (needed "
+        << n << " more bytes but only " << (size_ - offset_)
+        << " are available)";
+    throw Exception(err.str());
+  }
+}
+
+}  // namespace util
+
+}  // namespace s2geography
@@ -0,0 +1,45 @@
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "geoarrow-imports.h"
+#include "geography.h"
+
+namespace s2geography {
+
+namespace util {
+
+// Reads well-known binary (ISO or EWKB, either byte order) into a Handler
+// (usually a FeatureConstructor). Unlike a coordinate-at-a-time reader,
+// each linestring, ring, or point is passed to Handler::coords() as one
+// contiguous run of coordinates. One WKBReader should be used per thread.
+class WKBReader {
+ public:
+  explicit WKBReader(Handler* handler) : handler_(handler) {}
+
+  // Reads a single geometry from data, calling geom_start(), ring_start(),
+  // coords(), ring_end() and geom_end() on the handler. The caller is
+  // responsible for feature-level calls (e.g., feat_start()). Throws an
+  // Exception if data is not valid WKB.
+  void ReadGeometry(const uint8_t* data, int64_t size);
+
+ private:
+  Handler* handler_;
+  const uint8_t* data_;
+  int64_t size_;
+  int64_t offset_;
+  bool swap_endian_;
+  std::vector<double> coords_;
+
+  void ReadGeometry();
+  void ReadCoordinates(uint32_t n, int32_t coord_size);
+  uint8_t ReadUInt8();
+  uint32_t ReadUInt32();
+  void CheckAvailable(int64_t n);
+};
+
+}  // namespace util
+
+}  // namespace s2geography